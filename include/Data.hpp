@@ -5,136 +5,828 @@
 #include "Data/EditData.hpp"
 #include "Data/SetData.hpp"
 #include "Data/SetBoundedData.hpp"
+#include "Data/EditBoundedVector.hpp"
+#include "Data/HistoryData.hpp"
+#include "Data/MapData.hpp"
+#include "Data/IsrSetData.hpp"
+#include "Data/ViewData.hpp"
 
 #include "Model.hpp"
 
 #include "Data/Subscribe/Subscribe.hpp"
 #include "Data/Subscribe/SubscribeBasic.hpp"
+#include "Data/Subscribe/SubscribeQueued.hpp"
+#include "Data/Subscribe/SubscribeStatic.hpp"
+#include "Data/Subscribe/FieldSubscriber.hpp"
 
 #include "Data/Storage/Storage.hpp"
 #include "Data/Storage/StorageNone.hpp"
 #include "Data/Storage/StorageBasic.hpp"
 #include "Data/Storage/StorageVectorNone.hpp"
 #include "Data/Storage/StorageVectorBasic.hpp"
+#include "Data/Storage/StorageHistory.hpp"
+#include "Data/Storage/StorageMapped.hpp"
+#include "Data/Storage/StorageMap.hpp"
+#include "Data/Storage/StorageVersioned.hpp"
 
 #include "Data/Set/Set.hpp"
 #include "Data/Set/SetAlways.hpp"
 #include "Data/Set/SetDifferent.hpp"
+#include "Data/Set/SetDifferentBytes.hpp"
+#include "Data/Set/SetBounded.hpp"
+#include "Data/Set/SetBoundedVector.hpp"
 
 #include "Data/Edit/Edit.hpp"
 
+#include "Data/Executor/Executor.hpp"
+#include "Data/Executor/QueueExecutor.hpp"
+#include "Data/Await/Await.hpp"
+
+#include "Data/Helper/Codec.hpp"
+#include "Data/Helper/ChangeStream.hpp"
+#include "Data/Helper/Writer.hpp"
+#include "Data/Helper/LogBuffer.hpp"
+#include "Data/Helper/BoundedQueue.hpp"
+#include "Data/Helper/Arena.hpp"
+#include "Data/Helper/Function.hpp"
+#include "Data/Helper/ObjectArena.hpp"
+#include "Data/Helper/FixedMap.hpp"
+#include "Data/Helper/SmallVector.hpp"
+#include "Data/Helper/Span.hpp"
+#include "Data/Helper/MappedBlob.hpp"
+#include "Data/Helper/Journal.hpp"
+#include "Data/Helper/Bounds.hpp"
+#include "Data/Helper/Compare.hpp"
+#include "Data/Helper/Schema.hpp"
+#include "Data/Helper/NvsBackend.hpp"
+#include "Data/Helper/FlashDevice.hpp"
+#include "Data/Helper/FlashSim.hpp"
+#include "Data/Helper/NvsSim.hpp"
+
 // bwl component includes
 
 // Esp-idf component includes
 
 // Standard library includes
 
+#ifndef CONFIG_DATA_SUB_CAPACITY
+#define CONFIG_DATA_SUB_CAPACITY 4
+#endif
+
 namespace Data {
 
 namespace Factory {
 
+/**
+ * @brief Get the handler used by objects made by the Factory, the "storage" namespace
+ * of the default nvs partition, journaled to the CONFIG_DATA_JOURNAL_PARTITION
+ * partition when it is set
+ */
 Helper::NvsHandler *GetNvsHandler(void);
 
+/**
+ * @brief Get the handler of a namespace, made on first use. Each handler has its own
+ * dirty keys and is committed on its own, pass it to a Make function after the arena
+ * to keep fast changing values apart from rarely changing ones.
+ * @note nvs_namespace and partition are kept, they must outlive the program. Tasks asking
+ * for the same handler at once get the same one
+ *
+ * @param nvs_namespace Namespace to open, at most 15 characters
+ * @param partition Label of the nvs partition, nullptr for the default partition, it
+ * must have been initialized with nvs_flash_init_partition
+ */
+Helper::NvsHandler *GetNvsHandler(const char *nvs_namespace, const char *partition = nullptr);
+
+/**
+ * @brief Call fn with every handler made by GetNvsHandler, e.g. to commit them all
+ */
+void ForEachNvsHandler(const Helper::Callback<void(Helper::NvsHandler &)> &fn);
+
+/**
+ * @brief Get the dispatcher used by IsrSetData made by the Factory, a task must
+ * call wait and process on it for values set from interrupts to be applied
+ */
+Helper::IsrDispatcher *GetIsrDispatcher(void);
+
 /**
  * @brief Logic to handle setting the name is an nvs_key is provided and a name is not,
  * to set the nvs key in this case.
  */
 const char *get_name(const char *nvs_key, const char *name);
 
+/**
+ * @brief Get the arena that owns delegates made without one, it lives as long as the program
+ * and is made on first use from any task
+ */
+Helper::ObjectArena &GetObjectArena(void);
+
+/**
+ * @brief Memory the component is using, to size the CONFIG_DATA_NO_HEAP limits
+ * @note Capacities are 0 when the matching limit doesn't apply
+ *
+ */
+struct Usage {
+    size_t arena_used;
+    size_t arena_capacity;
+    size_t dirty_high_water;   // Of the handler closest to its capacity
+    size_t dirty_capacity;
+    size_t sub_high_water;
+    size_t sub_capacity;
+};
+
+/**
+ * @brief Get the component's current Usage
+ */
+Usage GetUsage(void);
+
+/**
+ * @brief Make the SubscribeDelegate used by the Factory, a SubscribeStatic of
+ * CONFIG_DATA_SUB_CAPACITY entries when built with CONFIG_DATA_NO_HEAP, otherwise a SubscribeBasic
+ *
+ */
+template <typename T>
+SubscribeDelegate<T> *MakeSubscribeDelegate(Helper::ObjectArena &arena) {
+#if CONFIG_DATA_NO_HEAP
+    return arena.create<SubscribeStatic<T, CONFIG_DATA_SUB_CAPACITY>>();
+#else
+    return arena.create<SubscribeBasic<T>>();
+#endif
+}
+
+template <typename T>
+SubscribeDelegate<T> *MakeSubscribeDelegate(void) {
+    return MakeSubscribeDelegate<T>(GetObjectArena());
+}
+
+/**
+ * @brief Make a FieldSubscriber of object, with its SubscribeDelegate owned by arena
+ *
+ */
+template <typename T>
+FieldSubscriber<T> MakeFieldSubscriber(Helper::ObjectArena &arena, BaseData<T> &object) {
+    return FieldSubscriber<T>(object, MakeSubscribeDelegate<T>(arena));
+}
+
+template <typename T>
+FieldSubscriber<T> MakeFieldSubscriber(BaseData<T> &object) {
+    return MakeFieldSubscriber(GetObjectArena(), object);
+}
+
 /**
  * @brief Make a StorageDelegate that is either StorageNone if the nvs key is NULL
- * or StorageBasic if the nvs key is not NULL
+ * or StorageBasic if the nvs key is not NULL, committed by handler (GetNvsHandler
+ * when nullptr) in the given priority and deadline
  *
  */
 template <typename T>
-StorageDelegate<T> *MakeStorageDelegate(const T default_value, const char *nvs_key) {
+StorageDelegate<T> *MakeStorageDelegate(Helper::ObjectArena &arena, Helper::NvsHandler *handler, T default_value, const char *nvs_key,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
     if (nvs_key == NULL) {
-        return new StorageNone<T>(default_value);
+        return arena.create<StorageNone<T>>(std::move(default_value));
     } else {
-        return new StorageBasic<T>(default_value, GetNvsHandler(), nvs_key);
+        return arena.create<StorageBasic<T>>(std::move(default_value), handler ? handler : GetNvsHandler(), nvs_key, priority, deadline_ms);
     }
 }
 
+template <typename T>
+StorageDelegate<T> *MakeStorageDelegate(Helper::ObjectArena &arena, T default_value, const char *nvs_key) {
+    return MakeStorageDelegate(arena, nullptr, std::move(default_value), nvs_key);
+}
+
+template <typename T>
+StorageDelegate<T> *MakeStorageDelegate(T default_value, const char *nvs_key) {
+    return MakeStorageDelegate(GetObjectArena(), std::move(default_value), nvs_key);
+}
+
 /**
- * @brief Make a StorageDelegate that is either StorageVectorNone if the nvs key is NULL
- * or StorageVectorBasic if the nvs key is not NULL
+ * @brief Make a StorageDelegate that is either StorageNone if the nvs key is NULL
+ * or StorageVersioned if the nvs key is not NULL, committed by handler (GetNvsHandler
+ * when nullptr) in the given priority and deadline
  *
  */
 template <typename T>
-StorageDelegate<std::vector<T>> *MakeStorageVectorDelegate(const char *nvs_key) {
+StorageDelegate<T> *MakeStorageVersioned(Helper::ObjectArena &arena, Helper::NvsHandler *handler, Helper::Schema<T> schema, T default_value, const char *nvs_key,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
     if (nvs_key == NULL) {
-        return new StorageVectorNone<T>();
+        return arena.create<StorageNone<T>>(std::move(default_value));
     } else {
-        return new StorageVectorBasic<T>(GetNvsHandler(), nvs_key);
+        return arena.create<StorageVersioned<T>>(std::move(default_value), schema, handler ? handler : GetNvsHandler(), nvs_key, priority, deadline_ms);
     }
 }
 
+template <typename T>
+StorageDelegate<T> *MakeStorageVersioned(Helper::ObjectArena &arena, Helper::Schema<T> schema, T default_value, const char *nvs_key) {
+    return MakeStorageVersioned(arena, nullptr, schema, std::move(default_value), nvs_key);
+}
+
+template <typename T>
+StorageDelegate<T> *MakeStorageVersioned(Helper::Schema<T> schema, T default_value, const char *nvs_key) {
+    return MakeStorageVersioned(GetObjectArena(), schema, std::move(default_value), nvs_key);
+}
+
 /**
- * @brief Make a SetData that uses the SetAlways SetDelegate
+ * @brief Make a StorageDelegate that is either StorageVectorNone if the nvs key is NULL
+ * or StorageVectorBasic if the nvs key is not NULL, committed by handler (GetNvsHandler
+ * when nullptr) in the given priority and deadline
  *
+ * @tparam V Vector type, std::vector or a Helper::SmallVector of T
  */
+template <typename T, typename V = std::vector<T>>
+StorageDelegate<V> *MakeStorageVectorDelegate(Helper::ObjectArena &arena, Helper::NvsHandler *handler, const char *nvs_key,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    if (nvs_key == NULL) {
+        return arena.create<StorageVectorNone<T, V>>();
+    } else {
+        return arena.create<StorageVectorBasic<T, V>>(handler ? handler : GetNvsHandler(), nvs_key, priority, deadline_ms);
+    }
+}
+
+template <typename T, typename V = std::vector<T>>
+StorageDelegate<V> *MakeStorageVectorDelegate(Helper::ObjectArena &arena, const char *nvs_key) {
+    return MakeStorageVectorDelegate<T, V>(arena, nullptr, nvs_key);
+}
+
+template <typename T, typename V = std::vector<T>>
+StorageDelegate<V> *MakeStorageVectorDelegate(const char *nvs_key) {
+    return MakeStorageVectorDelegate<T, V>(GetObjectArena(), nvs_key);
+}
+
+/**
+ * @brief Implementations of the Make functions taking a handler, nullptr for GetNvsHandler.
+ * The overloads with and without a handler both forward here.
+ * @note priority and deadline_ms are handed to the storage delegate, they order the commits
+ * of the data's nvs key, see Helper::NvsHandler::Priority
+ *
+ */
+namespace Impl {
+
 template <typename T>
-SetData<T> MakeSetAlways(const T default_value, const char *nvs_key, const char *name = nullptr) {
+SetData<T> MakeSetAlways(Helper::ObjectArena &arena, Helper::NvsHandler *handler, T default_value, const char *nvs_key, const char *name,
+        Helper::NvsHandler::Priority priority, uint32_t deadline_ms) {
     return SetData<T>(
-        new SubscribeBasic<T>(),
-        MakeStorageDelegate(default_value, nvs_key),
-        new SetAlways<T>(),
+        MakeSubscribeDelegate<T>(arena),
+        MakeStorageDelegate(arena, handler, std::move(default_value), nvs_key, priority, deadline_ms),
+        Helper::shared<SetAlways<T>>(),
         get_name(nvs_key, name)
     );
 }
 
-/**
- * @brief Make a SetData that uses the SetDifferent SetDelegate
- *
- */
+
+template <typename T>
+SetData<T> MakeSetDifferent(Helper::ObjectArena &arena, Helper::NvsHandler *handler, T default_value, const char *nvs_key, const char *name,
+        Helper::NvsHandler::Priority priority, uint32_t deadline_ms) {
+    return SetData<T>(
+        MakeSubscribeDelegate<T>(arena),
+        MakeStorageDelegate(arena, handler, std::move(default_value), nvs_key, priority, deadline_ms),
+        Helper::shared<SetDifferent<T>>(),
+        get_name(nvs_key, name)
+    );
+}
+
+
 template <typename T>
-SetData<T> MakeSetDifferent(const T default_value, const char *nvs_key, const char *name = nullptr) {
+SetData<T> MakeSetVersioned(Helper::ObjectArena &arena, Helper::NvsHandler *handler, Helper::Schema<T> schema, T default_value, const char *nvs_key, const char *name,
+        Helper::NvsHandler::Priority priority, uint32_t deadline_ms) {
     return SetData<T>(
-        new SubscribeBasic<T>(),
-        MakeStorageDelegate(default_value, nvs_key),
-        new SetDifferent<T>(),
+        MakeSubscribeDelegate<T>(arena),
+        MakeStorageVersioned(arena, handler, schema, std::move(default_value), nvs_key, priority, deadline_ms),
+        Helper::shared<SetAlways<T>>(),
+        get_name(nvs_key, name)
+    );
+}
+
+
+template <typename T>
+SetData<T> MakeSetDifferentBytes(Helper::ObjectArena &arena, Helper::NvsHandler *handler, T default_value, const char *nvs_key, const char *name,
+        Helper::NvsHandler::Priority priority, uint32_t deadline_ms) {
+    return SetData<T>(
+        MakeSubscribeDelegate<T>(arena),
+        MakeStorageDelegate(arena, handler, std::move(default_value), nvs_key, priority, deadline_ms),
+        arena.create<SetDifferentBytes<T>>(),
+        get_name(nvs_key, name)
+    );
+}
+
+
+template <typename T, typename V = std::vector<T>>
+SetData<V> MakeSetDifferentVector(Helper::ObjectArena &arena, Helper::NvsHandler *handler, const char *nvs_key, const char *name,
+        Helper::NvsHandler::Priority priority, uint32_t deadline_ms) {
+    return SetData<V>(
+        MakeSubscribeDelegate<V>(arena),
+        MakeStorageVectorDelegate<T, V>(arena, handler, nvs_key, priority, deadline_ms),
+        arena.create<SetDifferentBytes<V>>(),
+        get_name(nvs_key, name)
+    );
+}
+
+
+template <typename T>
+SetBoundedData<T> MakeSetBounded(Helper::ObjectArena &arena, Helper::NvsHandler *handler, T default_value, const T min, const T max, const char *nvs_key, const char *name,
+        Helper::NvsHandler::Priority priority, uint32_t deadline_ms) {
+    return SetBoundedData<T>(
+        MakeSubscribeDelegate<T>(arena),
+        MakeStorageDelegate(arena, handler, std::move(default_value), nvs_key, priority, deadline_ms),
+        arena.create<SetBounded<T>>(min, max),
+        get_name(nvs_key, name)
+    );
+}
+
+
+template <typename T>
+EditData<T> MakeEditData(Helper::ObjectArena &arena, Helper::NvsHandler *handler, T default_value, const char *nvs_key, const char *name,
+        Helper::NvsHandler::Priority priority, uint32_t deadline_ms) {
+    return EditData<T>(
+        MakeSubscribeDelegate<T>(arena),
+        MakeStorageDelegate(arena, handler, std::move(default_value), nvs_key, priority, deadline_ms),
+        get_name(nvs_key, name)
+    );
+}
+
+
+template <typename T>
+EditData<std::vector<T>> MakeEditVector(Helper::ObjectArena &arena, Helper::NvsHandler *handler, const char *nvs_key, const char *name,
+        Helper::NvsHandler::Priority priority, uint32_t deadline_ms) {
+    return EditData<std::vector<T>>(
+        MakeSubscribeDelegate<std::vector<T>>(arena),
+        MakeStorageVectorDelegate<T>(arena, handler, nvs_key, priority, deadline_ms),
+        get_name(nvs_key, name)
+    );
+}
+
+
+template <typename T, size_t N, size_t MAX = 0>
+EditData<Helper::SmallVector<T, N, MAX>> MakeEditSmallVector(Helper::ObjectArena &arena, Helper::NvsHandler *handler, const char *nvs_key, const char *name,
+        Helper::NvsHandler::Priority priority, uint32_t deadline_ms) {
+    using vector_t = Helper::SmallVector<T, N, MAX>;
+    return EditData<vector_t>(
+        MakeSubscribeDelegate<vector_t>(arena),
+        MakeStorageVectorDelegate<T, vector_t>(arena, handler, nvs_key, priority, deadline_ms),
+        get_name(nvs_key, name)
+    );
+}
+
+
+template <typename T, typename V = std::vector<T>>
+SetData<V> MakeSetBoundedVector(Helper::ObjectArena &arena, Helper::NvsHandler *handler, const T min, const T max, const char *nvs_key, const char *name,
+        Helper::NvsHandler::Priority priority, uint32_t deadline_ms) {
+    return SetData<V>(
+        MakeSubscribeDelegate<V>(arena),
+        MakeStorageVectorDelegate<T, V>(arena, handler, nvs_key, priority, deadline_ms),
+        arena.create<SetBoundedVector<T, V>>(min, max),
         get_name(nvs_key, name)
     );
 }
 
+
+template <typename T, typename V = std::vector<T>>
+EditBoundedVector<T, V> MakeEditBoundedVector(Helper::ObjectArena &arena, Helper::NvsHandler *handler, const T min, const T max, BoundsMode mode, const char *nvs_key, const char *name,
+        Helper::NvsHandler::Priority priority, uint32_t deadline_ms) {
+    return EditBoundedVector<T, V>(
+        MakeSubscribeDelegate<V>(arena),
+        MakeStorageVectorDelegate<T, V>(arena, handler, nvs_key, priority, deadline_ms),
+        min, max, mode,
+        get_name(nvs_key, name)
+    );
+}
+
+
+template <typename T>
+IsrSetData<T> MakeIsrSetDifferent(Helper::ObjectArena &arena, Helper::NvsHandler *handler, T default_value, const char *nvs_key, const char *name,
+        Helper::NvsHandler::Priority priority, uint32_t deadline_ms) {
+    return IsrSetData<T>(
+        MakeSubscribeDelegate<T>(arena),
+        MakeStorageDelegate(arena, handler, std::move(default_value), nvs_key, priority, deadline_ms),
+        Helper::shared<SetDifferent<T>>(),
+        GetIsrDispatcher(),
+        get_name(nvs_key, name)
+    );
+}
+
+
+template <typename T>
+IsrSetData<T> MakeIsrSetAlways(Helper::ObjectArena &arena, Helper::NvsHandler *handler, T default_value, const char *nvs_key, const char *name,
+        Helper::NvsHandler::Priority priority, uint32_t deadline_ms) {
+    return IsrSetData<T>(
+        MakeSubscribeDelegate<T>(arena),
+        MakeStorageDelegate(arena, handler, std::move(default_value), nvs_key, priority, deadline_ms),
+        Helper::shared<SetAlways<T>>(),
+        GetIsrDispatcher(),
+        get_name(nvs_key, name)
+    );
+}
+
+
+template <typename K, typename V, size_t N, size_t CHUNK_N = 8, typename Cmp = std::less<K>>
+MapData<K, V, N, Cmp> MakeMap(Helper::ObjectArena &arena, Helper::NvsHandler *handler, const char *nvs_key, const char *name,
+        Helper::NvsHandler::Priority priority, uint32_t deadline_ms) {
+    using table_t = typename MapData<K, V, N, Cmp>::table_t;
+    return MapData<K, V, N, Cmp>(
+        MakeSubscribeDelegate<table_t>(arena),
+        MakeSubscribeDelegate<typename MapData<K, V, N, Cmp>::change_t>(arena),
+        arena.create<StorageMap<table_t, CHUNK_N>>(nvs_key ? (handler ? handler : GetNvsHandler()) : nullptr, nvs_key, priority, deadline_ms),
+        get_name(nvs_key, name)
+    );
+}
+
+
+template <typename T>
+ViewData<T> MakeView(Helper::ObjectArena &arena, Helper::NvsHandler *handler, const char *label, size_t offset, const char *nvs_key, const char *name) {
+    return ViewData<T>(
+        MakeSubscribeDelegate<Helper::Span<const T>>(arena),
+        arena.create<StorageMapped<T>>(label, offset, nvs_key ? (handler ? handler : GetNvsHandler()) : nullptr, nvs_key),
+        get_name(nvs_key ? nvs_key : label, name)
+    );
+}
+
+
+template <typename T, size_t RAW_N, size_t SEC_N = 60, size_t MIN_N = 60, size_t SEG_N = 16>
+HistoryData<T, RAW_N, SEC_N, MIN_N> MakeHistory(Helper::ObjectArena &arena, Helper::NvsHandler *handler, T default_value, const char *nvs_key, const char *name,
+        Helper::NvsHandler::Priority priority, uint32_t deadline_ms) {
+    using history_t = typename HistoryData<T, RAW_N, SEC_N, MIN_N>::history_t;
+    history_t *history = arena.create<history_t>();
+    StorageDelegate<T> *store_d;
+    if (nvs_key == NULL) {
+        store_d = arena.create<StorageNone<T>>(std::move(default_value));
+    } else {
+        store_d = arena.create<StorageHistory<T, history_t, SEG_N>>(std::move(default_value), history, handler ? handler : GetNvsHandler(), nvs_key, priority, deadline_ms);
+    }
+    return HistoryData<T, RAW_N, SEC_N, MIN_N>(
+        MakeSubscribeDelegate<T>(arena),
+        store_d,
+        Helper::shared<SetAlways<T>>(),
+        history,
+        get_name(nvs_key, name)
+    );
+}
+
+
+};
+
 /**
- * @brief Make a SetData that uses the SetBounded SetDelegate
+ * @brief Make a SetData that uses the shared SetAlways SetDelegate, with its other
+ * delegates owned by arena
  *
  */
 template <typename T>
-SetBoundedData<T> MakeSetBounded(const T default_value, const T min, const T max, const char *nvs_key, const char *name = nullptr) {
-    return SetBoundedData<T>(
-        new SubscribeBasic<T>(),
-        MakeStorageDelegate(default_value, nvs_key),
-        min, max, get_name(nvs_key, name)
+SetData<T> MakeSetAlways(Helper::ObjectArena &arena, T default_value, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return Impl::MakeSetAlways(arena, nullptr, std::move(default_value), nvs_key, name, priority, deadline_ms);
+}
 
-    );
+template <typename T>
+SetData<T> MakeSetAlways(Helper::ObjectArena &arena, Helper::NvsHandler &handler, T default_value, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return Impl::MakeSetAlways(arena, &handler, std::move(default_value), nvs_key, name, priority, deadline_ms);
+}
+
+template <typename T>
+SetData<T> MakeSetAlways(T default_value, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return MakeSetAlways(GetObjectArena(), std::move(default_value), nvs_key, name, priority, deadline_ms);
 }
 
 /**
- * @brief Make an EditData
+ * @brief Make a SetData that uses the shared SetDifferent SetDelegate, with its other
+ * delegates owned by arena
  *
  */
 template <typename T>
-EditData<T> MakeEditData(const T default_value, const char *nvs_key, const char *name = nullptr) {
-    return EditData<T>(
-        new SubscribeBasic<T>(),
-        MakeStorageDelegate(default_value, nvs_key),
-        get_name(nvs_key, name)
-    );
+SetData<T> MakeSetDifferent(Helper::ObjectArena &arena, T default_value, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return Impl::MakeSetDifferent(arena, nullptr, std::move(default_value), nvs_key, name, priority, deadline_ms);
+}
+
+template <typename T>
+SetData<T> MakeSetDifferent(Helper::ObjectArena &arena, Helper::NvsHandler &handler, T default_value, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return Impl::MakeSetDifferent(arena, &handler, std::move(default_value), nvs_key, name, priority, deadline_ms);
+}
+
+template <typename T>
+SetData<T> MakeSetDifferent(T default_value, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return MakeSetDifferent(GetObjectArena(), std::move(default_value), nvs_key, name, priority, deadline_ms);
 }
 
 /**
- * @brief Make an EditData that stores vectors of values
+ * @brief Make a SetData that uses the shared SetAlways SetDelegate and is stored
+ * with the version of its layout, see StorageVersioned, with its other delegates owned by arena
  *
  */
 template <typename T>
-EditData<std::vector<T>> MakeEditVector(const char *nvs_key, const char *name = nullptr) {
-    return EditData<std::vector<T>>(
-        new SubscribeBasic<std::vector<T>>(),
-        MakeStorageVectorDelegate<T>(nvs_key),
-        get_name(nvs_key, name)
-    );
+SetData<T> MakeSetVersioned(Helper::ObjectArena &arena, Helper::Schema<T> schema, T default_value, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return Impl::MakeSetVersioned(arena, nullptr, schema, std::move(default_value), nvs_key, name, priority, deadline_ms);
+}
+
+template <typename T>
+SetData<T> MakeSetVersioned(Helper::ObjectArena &arena, Helper::NvsHandler &handler, Helper::Schema<T> schema, T default_value, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return Impl::MakeSetVersioned(arena, &handler, schema, std::move(default_value), nvs_key, name, priority, deadline_ms);
+}
+
+template <typename T>
+SetData<T> MakeSetVersioned(Helper::Schema<T> schema, T default_value, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return MakeSetVersioned(GetObjectArena(), schema, std::move(default_value), nvs_key, name, priority, deadline_ms);
+}
+
+/**
+ * @brief Make a SetData of a large trivially copyable value that uses its own
+ * SetDifferentBytes SetDelegate, with its delegates owned by arena
+ *
+ */
+template <typename T>
+SetData<T> MakeSetDifferentBytes(Helper::ObjectArena &arena, T default_value, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return Impl::MakeSetDifferentBytes(arena, nullptr, std::move(default_value), nvs_key, name, priority, deadline_ms);
+}
+
+template <typename T>
+SetData<T> MakeSetDifferentBytes(Helper::ObjectArena &arena, Helper::NvsHandler &handler, T default_value, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return Impl::MakeSetDifferentBytes(arena, &handler, std::move(default_value), nvs_key, name, priority, deadline_ms);
+}
+
+template <typename T>
+SetData<T> MakeSetDifferentBytes(T default_value, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return MakeSetDifferentBytes(GetObjectArena(), std::move(default_value), nvs_key, name, priority, deadline_ms);
+}
+
+/**
+ * @brief Make a SetData of a vector of trivially copyable elements that uses its own
+ * SetDifferentBytes SetDelegate, with its delegates owned by arena
+ *
+ * @tparam V Vector type, std::vector or a Helper::SmallVector of T
+ */
+template <typename T, typename V = std::vector<T>>
+SetData<V> MakeSetDifferentVector(Helper::ObjectArena &arena, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return Impl::MakeSetDifferentVector<T, V>(arena, nullptr, nvs_key, name, priority, deadline_ms);
+}
+
+template <typename T, typename V = std::vector<T>>
+SetData<V> MakeSetDifferentVector(Helper::ObjectArena &arena, Helper::NvsHandler &handler, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return Impl::MakeSetDifferentVector<T, V>(arena, &handler, nvs_key, name, priority, deadline_ms);
+}
+
+template <typename T, typename V = std::vector<T>>
+SetData<V> MakeSetDifferentVector(const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return MakeSetDifferentVector<T, V>(GetObjectArena(), nvs_key, name, priority, deadline_ms);
+}
+
+/**
+ * @brief Make a SetData that uses the SetBounded SetDelegate, with its delegates owned by arena
+ *
+ */
+template <typename T>
+SetBoundedData<T> MakeSetBounded(Helper::ObjectArena &arena, T default_value, const T min, const T max, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return Impl::MakeSetBounded(arena, nullptr, std::move(default_value), min, max, nvs_key, name, priority, deadline_ms);
+}
+
+template <typename T>
+SetBoundedData<T> MakeSetBounded(Helper::ObjectArena &arena, Helper::NvsHandler &handler, T default_value, const T min, const T max, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return Impl::MakeSetBounded(arena, &handler, std::move(default_value), min, max, nvs_key, name, priority, deadline_ms);
+}
+
+template <typename T>
+SetBoundedData<T> MakeSetBounded(T default_value, const T min, const T max, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return MakeSetBounded(GetObjectArena(), std::move(default_value), min, max, nvs_key, name, priority, deadline_ms);
+}
+
+/**
+ * @brief Make an EditData, with its delegates owned by arena
+ *
+ */
+template <typename T>
+EditData<T> MakeEditData(Helper::ObjectArena &arena, T default_value, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return Impl::MakeEditData(arena, nullptr, std::move(default_value), nvs_key, name, priority, deadline_ms);
+}
+
+template <typename T>
+EditData<T> MakeEditData(Helper::ObjectArena &arena, Helper::NvsHandler &handler, T default_value, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return Impl::MakeEditData(arena, &handler, std::move(default_value), nvs_key, name, priority, deadline_ms);
+}
+
+template <typename T>
+EditData<T> MakeEditData(T default_value, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return MakeEditData(GetObjectArena(), std::move(default_value), nvs_key, name, priority, deadline_ms);
+}
+
+/**
+ * @brief Make an EditData that stores vectors of values, with its delegates owned by arena
+ *
+ */
+template <typename T>
+EditData<std::vector<T>> MakeEditVector(Helper::ObjectArena &arena, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return Impl::MakeEditVector<T>(arena, nullptr, nvs_key, name, priority, deadline_ms);
+}
+
+template <typename T>
+EditData<std::vector<T>> MakeEditVector(Helper::ObjectArena &arena, Helper::NvsHandler &handler, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return Impl::MakeEditVector<T>(arena, &handler, nvs_key, name, priority, deadline_ms);
+}
+
+template <typename T>
+EditData<std::vector<T>> MakeEditVector(const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return MakeEditVector<T>(GetObjectArena(), nvs_key, name, priority, deadline_ms);
+}
+
+/**
+ * @brief Make an EditData that stores a Helper::SmallVector of values, which only
+ * allocates once it holds more than N of them, with its delegates owned by arena
+ *
+ * @tparam N Number of values held inline
+ * @tparam MAX Hard maximum number of values, 0 for no maximum
+ */
+template <typename T, size_t N, size_t MAX = 0>
+EditData<Helper::SmallVector<T, N, MAX>> MakeEditSmallVector(Helper::ObjectArena &arena, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return Impl::MakeEditSmallVector<T, N, MAX>(arena, nullptr, nvs_key, name, priority, deadline_ms);
+}
+
+template <typename T, size_t N, size_t MAX = 0>
+EditData<Helper::SmallVector<T, N, MAX>> MakeEditSmallVector(Helper::ObjectArena &arena, Helper::NvsHandler &handler, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return Impl::MakeEditSmallVector<T, N, MAX>(arena, &handler, nvs_key, name, priority, deadline_ms);
+}
+
+template <typename T, size_t N, size_t MAX = 0>
+EditData<Helper::SmallVector<T, N, MAX>> MakeEditSmallVector(const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return MakeEditSmallVector<T, N, MAX>(GetObjectArena(), nvs_key, name, priority, deadline_ms);
+}
+
+/**
+ * @brief Make a SetData of a vector that is only set when every element is within [min, max),
+ * with its delegates owned by arena
+ *
+ * @tparam V Vector type, std::vector or a Helper::SmallVector of T
+ */
+template <typename T, typename V = std::vector<T>>
+SetData<V> MakeSetBoundedVector(Helper::ObjectArena &arena, const T min, const T max, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return Impl::MakeSetBoundedVector<T, V>(arena, nullptr, min, max, nvs_key, name, priority, deadline_ms);
+}
+
+template <typename T, typename V = std::vector<T>>
+SetData<V> MakeSetBoundedVector(Helper::ObjectArena &arena, Helper::NvsHandler &handler, const T min, const T max, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return Impl::MakeSetBoundedVector<T, V>(arena, &handler, min, max, nvs_key, name, priority, deadline_ms);
+}
+
+template <typename T, typename V = std::vector<T>>
+SetData<V> MakeSetBoundedVector(const T min, const T max, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return MakeSetBoundedVector<T, V>(GetObjectArena(), min, max, nvs_key, name, priority, deadline_ms);
+}
+
+/**
+ * @brief Make an EditBoundedVector that rejects or clamps edits leaving elements outside
+ * of [min, max), with its delegates owned by arena
+ *
+ * @tparam V Vector type, std::vector or a Helper::SmallVector of T
+ */
+template <typename T, typename V = std::vector<T>>
+EditBoundedVector<T, V> MakeEditBoundedVector(Helper::ObjectArena &arena, const T min, const T max, BoundsMode mode, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return Impl::MakeEditBoundedVector<T, V>(arena, nullptr, min, max, mode, nvs_key, name, priority, deadline_ms);
+}
+
+template <typename T, typename V = std::vector<T>>
+EditBoundedVector<T, V> MakeEditBoundedVector(Helper::ObjectArena &arena, Helper::NvsHandler &handler, const T min, const T max, BoundsMode mode, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return Impl::MakeEditBoundedVector<T, V>(arena, &handler, min, max, mode, nvs_key, name, priority, deadline_ms);
+}
+
+template <typename T, typename V = std::vector<T>>
+EditBoundedVector<T, V> MakeEditBoundedVector(const T min, const T max, BoundsMode mode, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return MakeEditBoundedVector<T, V>(GetObjectArena(), min, max, mode, nvs_key, name, priority, deadline_ms);
+}
+
+/**
+ * @brief Make an IsrSetData that uses the shared SetDifferent SetDelegate, with its other
+ * delegates owned by arena
+ *
+ */
+template <typename T>
+IsrSetData<T> MakeIsrSetDifferent(Helper::ObjectArena &arena, T default_value, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return Impl::MakeIsrSetDifferent(arena, nullptr, std::move(default_value), nvs_key, name, priority, deadline_ms);
+}
+
+template <typename T>
+IsrSetData<T> MakeIsrSetDifferent(Helper::ObjectArena &arena, Helper::NvsHandler &handler, T default_value, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return Impl::MakeIsrSetDifferent(arena, &handler, std::move(default_value), nvs_key, name, priority, deadline_ms);
+}
+
+template <typename T>
+IsrSetData<T> MakeIsrSetDifferent(T default_value, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return MakeIsrSetDifferent(GetObjectArena(), std::move(default_value), nvs_key, name, priority, deadline_ms);
+}
+
+/**
+ * @brief Make an IsrSetData that uses the shared SetAlways SetDelegate, with its other
+ * delegates owned by arena
+ *
+ */
+template <typename T>
+IsrSetData<T> MakeIsrSetAlways(Helper::ObjectArena &arena, T default_value, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return Impl::MakeIsrSetAlways(arena, nullptr, std::move(default_value), nvs_key, name, priority, deadline_ms);
+}
+
+template <typename T>
+IsrSetData<T> MakeIsrSetAlways(Helper::ObjectArena &arena, Helper::NvsHandler &handler, T default_value, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return Impl::MakeIsrSetAlways(arena, &handler, std::move(default_value), nvs_key, name, priority, deadline_ms);
+}
+
+template <typename T>
+IsrSetData<T> MakeIsrSetAlways(T default_value, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return MakeIsrSetAlways(GetObjectArena(), std::move(default_value), nvs_key, name, priority, deadline_ms);
+}
+
+/**
+ * @brief Make a MapData of up to N entries persisted in chunks of CHUNK_N slots if the
+ * nvs key is not NULL, with its delegates owned by arena
+ *
+ */
+template <typename K, typename V, size_t N, size_t CHUNK_N = 8, typename Cmp = std::less<K>>
+MapData<K, V, N, Cmp> MakeMap(Helper::ObjectArena &arena, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return Impl::MakeMap<K, V, N, CHUNK_N, Cmp>(arena, nullptr, nvs_key, name, priority, deadline_ms);
+}
+
+template <typename K, typename V, size_t N, size_t CHUNK_N = 8, typename Cmp = std::less<K>>
+MapData<K, V, N, Cmp> MakeMap(Helper::ObjectArena &arena, Helper::NvsHandler &handler, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return Impl::MakeMap<K, V, N, CHUNK_N, Cmp>(arena, &handler, nvs_key, name, priority, deadline_ms);
+}
+
+template <typename K, typename V, size_t N, size_t CHUNK_N = 8, typename Cmp = std::less<K>>
+MapData<K, V, N, Cmp> MakeMap(const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return MakeMap<K, V, N, CHUNK_N, Cmp>(GetObjectArena(), nvs_key, name, priority, deadline_ms);
+}
+
+/**
+ * @brief Make a ViewData of a table in the data partition labeled label, falling back
+ * to the nvs blob under nvs_key when there is no such partition, with its delegates owned by arena
+ *
+ */
+template <typename T>
+ViewData<T> MakeView(Helper::ObjectArena &arena, const char *label, size_t offset, const char *nvs_key, const char *name = nullptr) {
+    return Impl::MakeView<T>(arena, nullptr, label, offset, nvs_key, name);
+}
+
+template <typename T>
+ViewData<T> MakeView(Helper::ObjectArena &arena, Helper::NvsHandler &handler, const char *label, size_t offset, const char *nvs_key, const char *name = nullptr) {
+    return Impl::MakeView<T>(arena, &handler, label, offset, nvs_key, name);
+}
+
+template <typename T>
+ViewData<T> MakeView(const char *label, size_t offset, const char *nvs_key, const char *name = nullptr) {
+    return MakeView<T>(GetObjectArena(), label, offset, nvs_key, name);
+}
+
+/**
+ * @brief Make a HistoryData that records every set, persisting its raw samples in segments
+ * of SEG_N if the nvs key is not NULL, with its history and delegates owned by arena
+ *
+ */
+template <typename T, size_t RAW_N, size_t SEC_N = 60, size_t MIN_N = 60, size_t SEG_N = 16>
+HistoryData<T, RAW_N, SEC_N, MIN_N> MakeHistory(Helper::ObjectArena &arena, T default_value, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return Impl::MakeHistory<T, RAW_N, SEC_N, MIN_N, SEG_N>(arena, nullptr, std::move(default_value), nvs_key, name, priority, deadline_ms);
+}
+
+template <typename T, size_t RAW_N, size_t SEC_N = 60, size_t MIN_N = 60, size_t SEG_N = 16>
+HistoryData<T, RAW_N, SEC_N, MIN_N> MakeHistory(Helper::ObjectArena &arena, Helper::NvsHandler &handler, T default_value, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return Impl::MakeHistory<T, RAW_N, SEC_N, MIN_N, SEG_N>(arena, &handler, std::move(default_value), nvs_key, name, priority, deadline_ms);
+}
+
+template <typename T, size_t RAW_N, size_t SEC_N = 60, size_t MIN_N = 60, size_t SEG_N = 16>
+HistoryData<T, RAW_N, SEC_N, MIN_N> MakeHistory(T default_value, const char *nvs_key, const char *name = nullptr,
+        Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) {
+    return MakeHistory<T, RAW_N, SEC_N, MIN_N, SEG_N>(GetObjectArena(), std::move(default_value), nvs_key, name, priority, deadline_ms);
 }
 
 };
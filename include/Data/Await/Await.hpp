@@ -0,0 +1,273 @@
+#pragma once
+
+// Internal includes
+#include "Data/Executor/Executor.hpp"
+#include "Data/Helper/Arena.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+#include "FreeRTOS/FreeRTOS.h"
+#include "FreeRTOS/semphr.h"
+#include "sdkconfig.h"
+
+// Standard library includes
+#if __cpp_impl_coroutine
+#include <coroutine>
+#include <cstddef>
+#include <memory>
+#endif
+
+#if __cpp_impl_coroutine
+
+namespace Data {
+
+template<class T>
+class BaseData;
+
+namespace Helper {
+
+/**
+ * @brief Resume a coroutine, either inline or through an executor
+ * @note When the executor's queue is full the coroutine is resumed inline instead, on
+ * the calling task, rather than being lost
+ */
+inline void resume_on(Executor *executor, std::coroutine_handle<> handle) {
+    bool posted = executor && executor->post([](void *address) {
+        std::coroutine_handle<>::from_address(address).resume();
+    }, handle.address());
+    if (!posted) {
+        handle.resume();
+    }
+}
+
+/**
+ * @brief State an awaitable shares with its subscriber callback, the callback holds a
+ * reference so the state (and its mutex) lives until no notify can still be running it
+ */
+struct AwaitState {
+    AwaitState(void) {
+#if CONFIG_DATA_NO_HEAP
+        sem_h = xSemaphoreCreateMutexStatic(&sem_buf);
+#else
+        sem_h = xSemaphoreCreateMutex();
+#endif
+    }
+
+    AwaitState(const AwaitState &) = delete;
+
+    ~AwaitState() {
+        vSemaphoreDelete(sem_h);
+    }
+
+    void lock(void) {
+        xSemaphoreTake(sem_h, portMAX_DELAY);
+    }
+
+    void unlock(void) {
+        xSemaphoreGive(sem_h);
+    }
+private:
+    SemaphoreHandle_t sem_h;
+#if CONFIG_DATA_NO_HEAP
+    StaticSemaphore_t sem_buf;
+#endif
+};
+
+};
+
+/**
+ * @brief Awaitable that resumes the awaiting coroutine with the next value a BaseData
+ * notifies, returned by BaseData::next_change
+ * @note Subscribes when awaited, the callback unsubscribes itself from inside the notify
+ * that resumes the coroutine. Only a NextChange destroyed while still waiting unsubscribes
+ * from its destructor. Without an executor the coroutine resumes inside the notify, before
+ * the BaseData's own value has been updated.
+ *
+ * @tparam T Type of value being awaited
+ */
+template <typename T>
+class NextChange {
+public:
+    NextChange(BaseData<T> &data, Executor *executor) :
+        data(data), executor(executor), state() { }
+
+    NextChange(const NextChange &) = delete;
+
+    ~NextChange() {
+        if (state) {
+            state->lock();
+            if (state->subscribed) {
+                state->subscribed = false;
+                state->handle = nullptr;
+                data.unsub(state->sub_id);
+            }
+            state->unlock();
+        }
+    }
+
+    bool await_ready(void) const noexcept {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+        state = std::allocate_shared<State>(Helper::Allocator<State>());
+        state->handle = handle;
+        // Held across sub so a notify from another task waits for the sub id
+        state->lock();
+        std::shared_ptr<State> shared = state;
+        BaseData<T> *source = &data;
+        Executor *resume_executor = executor;
+        state->sub_id = data.sub([shared, source, resume_executor](const T &next) {
+            shared->lock();
+            std::coroutine_handle<> waiter = shared->handle;
+            if (waiter) {
+                shared->value = next;
+                shared->handle = nullptr;
+                shared->subscribed = false;
+                // Unsubscribing while notifying only destroys this callback once the notify is done
+                source->unsub(shared->sub_id);
+            }
+            shared->unlock();
+            if (waiter) {
+                Helper::resume_on(resume_executor, waiter);
+            }
+        });
+        state->subscribed = true;
+        state->unlock();
+    }
+
+    T await_resume(void) {
+        return state->value;
+    }
+private:
+    struct State : public Helper::AwaitState {
+        State(void) :
+            value(), handle(), sub_id(0), subscribed(false) { }
+
+        T value;
+        std::coroutine_handle<> handle;
+        size_t sub_id;
+        bool subscribed;
+    };
+
+    BaseData<T> &data;
+    Executor *executor;
+    std::shared_ptr<State> state;
+};
+
+/**
+ * @brief Subscription that lets a coroutine await a BaseData's changes one after another,
+ * returned by BaseData::changes
+ * @note Changes that happen while the coroutine is busy are coalesced, the next await
+ * returns immediately with the latest value. The value and waiter are guarded by a
+ * mutex, so the notifying task and the coroutine's executor can be different tasks.
+ * The state is shared with the subscriber callback, a notify still running it when the
+ * Changes is destroyed finds it closed.
+ *
+ *     auto changes = data.changes(&executor);
+ *     while (true) {
+ *         T value = co_await changes.next();
+ *     }
+ *
+ * @tparam T Type of value being awaited
+ */
+template <typename T>
+class Changes {
+public:
+    /**
+     * @brief Awaitable returned by next
+     */
+    class Next {
+    public:
+        Next(Changes &changes) :
+            changes(changes) { }
+
+        bool await_ready(void) const noexcept {
+            changes.state->lock();
+            bool ready = changes.state->pending;
+            changes.state->unlock();
+            return ready;
+        }
+
+        /**
+         * @brief Publish the waiter, unless a change arrived since await_ready in which
+         * case the coroutine carries on without suspending
+         */
+        bool await_suspend(std::coroutine_handle<> handle) {
+            changes.state->lock();
+            bool suspend = !changes.state->pending;
+            if (suspend) {
+                changes.state->waiter = handle;
+            }
+            changes.state->unlock();
+            return suspend;
+        }
+
+        T await_resume(void) {
+            changes.state->lock();
+            T value = changes.state->latest;
+            changes.state->pending = false;
+            changes.state->unlock();
+            return value;
+        }
+    private:
+        Changes &changes;
+    };
+
+    Changes(BaseData<T> &data, Executor *executor) :
+        data(data), state(std::allocate_shared<State>(Helper::Allocator<State>()))
+    {
+        std::shared_ptr<State> shared = state;
+        sub_id = data.sub([shared, executor](const T &next) {
+            shared->lock();
+            if (shared->closed) {
+                shared->unlock();
+                return;
+            }
+            shared->latest = next;
+            shared->pending = true;
+            std::coroutine_handle<> handle = shared->waiter;
+            shared->waiter = nullptr;
+            shared->unlock();
+            if (handle) {
+                Helper::resume_on(executor, handle);
+            }
+        });
+    }
+
+    Changes(const Changes &) = delete;
+
+    ~Changes() {
+        state->lock();
+        state->closed = true;
+        state->waiter = nullptr;
+        state->unlock();
+        data.unsub(sub_id);
+    }
+
+    /**
+     * @brief Await the next change, or the latest one if it has not been awaited yet
+     */
+    Next next(void) {
+        return Next(*this);
+    }
+private:
+    struct State : public Helper::AwaitState {
+        State(void) :
+            latest(), pending(false), closed(false), waiter() { }
+
+        T latest;
+        bool pending;
+        bool closed;
+        std::coroutine_handle<> waiter;
+    };
+
+    BaseData<T> &data;
+    std::shared_ptr<State> state;
+    size_t sub_id;
+};
+
+};
+
+#endif
@@ -2,14 +2,23 @@
 
 // Internal includes
 #include "Subscribe/Subscribe.hpp"
+#include "Subscribe/SubscribeQueued.hpp"
 #include "Storage/Storage.hpp"
+#include "Helper/Codec.hpp"
+#include "Helper/LogBuffer.hpp"
+#include "Helper/SubMonitor.hpp"
+#include "Helper/Writer.hpp"
+#include "Await/Await.hpp"
+#include "Helper/Function.hpp"
 
 // bwl component includes
 
 // Esp-idf component includes
 
 // Standard library includes
-#include <iostream>
+#include <functional>
+#include <memory>
+#include <utility>
 
 namespace Data {
 
@@ -18,14 +27,149 @@ namespace Data {
  */
 class BaseDataGeneric{
 public:
+    /**
+     * @brief Callback function used when a generic subscriber is notified
+     *
+     * @param BaseDataGeneric The object that is changing
+     */
+    using change_cb_t = Helper::Callback<void(BaseDataGeneric &)>;
+
     BaseDataGeneric(const char *name) : name(name) {}
+
+    /**
+     * @brief Get the name of the object, may be nullptr
+     */
+    const char *get_name(void) const {
+        return name;
+    }
+
+    /**
+     * @brief Call fn with every object holding a value, Models pass on to their children
+     *
+     * @param fn Function called with each object
+     */
+    virtual void for_each(const Helper::Callback<void(BaseDataGeneric &)> &fn) {
+        fn(*this);
+    }
+
+    /**
+     * @brief Subscribe to changes without knowing the held type
+     * @note Called before the new value is copied in, use get or encode after the notify
+     * to see the new value. Models have no value and never notify.
+     *
+     * @param change_cb Callback to be called when the internal value changes
+     * @return size_t id to be used to unsub_change
+     */
+    virtual size_t sub_change(change_cb_t change_cb) {
+        return 0;
+    }
+
+    /**
+     * @brief Unsubscribe a callback added with sub_change
+     *
+     * @param sub_id id returned by sub_change
+     */
+    virtual void unsub_change(size_t sub_id) { }
+
+    /**
+     * @brief Whether or not the held type has a Helper::Codec
+     */
+    virtual bool is_encodable(void) const {
+        return false;
+    }
+
+    /**
+     * @brief Number of bytes encode will write
+     */
+    virtual size_t encoded_size(void) const {
+        return 0;
+    }
+
+    /**
+     * @brief Encode the value using its Helper::Codec
+     *
+     * @param buf Buffer to encode into
+     * @param buf_sz Size of buf
+     * @return size_t Number of bytes written, 0 if buf is too small or the value can't be encoded
+     */
+    virtual size_t encode(uint8_t *buf, size_t buf_sz) const {
+        return 0;
+    }
+
+    /**
+     * @brief Decode a new value using its Helper::Codec, then notify and store it
+     *
+     * @param buf Buffer holding an encoded value
+     * @param buf_sz Size of the encoded value
+     * @retval True if the value was decoded
+     */
+    virtual bool decode(const uint8_t *buf, size_t buf_sz) {
+        return false;
+    }
+
+    /**
+     * @brief Decode a new value using its Helper::Codec and set it like set does, checked
+     * by the SetDelegate of objects that have one, then notify without storing it
+     * @note Used to set values in batches that are stored once at the end, see store
+     *
+     * @param buf Buffer holding an encoded value
+     * @param buf_sz Size of the encoded value
+     * @retval True if the value was decoded and not rejected by the SetDelegate
+     */
+    virtual bool set_encoded(const uint8_t *buf, size_t buf_sz) {
+        return false;
+    }
+
+    /**
+     * @brief Store the value, e.g. after set_encoded
+     */
+    virtual void store(void) { }
+
     /**
      * @brief Print the BaseData
      */
     virtual void print(uint32_t indent_depth = 0) = 0;
 
     /**
-     * @brief Print the BaseData everytime it notifies its subscribers
+     * @brief Write the BaseData as "name: value" lines, or as a JSON member ("name":value)
+     * with depth 0 wrapping it in an object
+     *
+     * @param writer Writer to use
+     * @param depth Nesting depth, used for indentation in text mode
+     */
+    virtual void export_to(Helper::Writer &writer, uint32_t depth = 0) const = 0;
+
+    /**
+     * @brief Write only the value using its Helper::Format
+     */
+    virtual void format_value(Helper::Writer &writer) const { }
+
+    /**
+     * @brief Write a value encoded with encode using its Helper::Format
+     */
+    virtual void format_encoded(Helper::Writer &writer, const uint8_t *buf, size_t buf_sz) const { }
+
+    /**
+     * @brief Export into a fixed buffer one chunk at a time
+     * @note Each call re-runs the export and skips what was already written,
+     * so nothing has to be kept between calls
+     *
+     * @param mode Plain text or JSON
+     * @param buf Buffer to write the chunk into
+     * @param buf_sz Size of buf
+     * @param offset Bytes already exported, advanced by the size of the chunk
+     * @return size_t Size of the chunk, 0 once everything has been exported
+     */
+    size_t export_chunk(Helper::Writer::Mode mode, char *buf, size_t buf_sz, size_t &offset) const {
+        Helper::BufferSink sink(buf, buf_sz);
+        Helper::Writer writer(sink, mode, offset);
+        export_to(writer);
+        offset += sink.size();
+        return sink.size();
+    }
+
+    /**
+     * @brief Record the BaseData's changes to Helper::GetLogBuffer everytime it notifies its subscribers
      */
     virtual void log_on_sub(bool set = true) = 0;
 
@@ -39,6 +183,13 @@ public:
      */
     virtual void unmute_sub() = 0;
 
+    /**
+     * @brief Whether or not subscribers are muted
+     */
+    virtual bool is_muted(void) const {
+        return false;
+    }
+
     /**
      * @brief Reset the object's internal value to its default state, maintaining its stored value
      *
@@ -58,6 +209,20 @@ public:
      * @param value Reference to the value being loaded / reset
      */
     virtual void load_or_reset(void) = 0;
+
+    /**
+     * @brief Get the nvs key the value is stored under, nullptr if it isn't stored in nvs
+     */
+    virtual const char *get_nvs_key(void) const {
+        return nullptr;
+    }
+
+    /**
+     * @brief Get the handler the value is stored with, nullptr if it isn't stored in nvs
+     */
+    virtual Helper::NvsHandler *get_nvs_handler(void) const {
+        return nullptr;
+    }
 protected:
     const char *name;
 };
@@ -72,6 +237,7 @@ template <typename T>
 class BaseData : public BaseDataGeneric
 {
 public:
+    using value_type = T;
     using sub_id_t = typename SubscribeDelegate<T>::sub_id_t;
     using sub_cb_t = typename SubscribeDelegate<T>::sub_cb_t;
 
@@ -102,15 +268,52 @@ public:
     BaseData(BaseData<T> &&) = default;
 
     /**
-     * @brief Print the object's value. Object's type must provide it's own printing ability
-     * via overriding the ostream << operator
+     * @brief Destructor, forgets the subscribers Helper::GetSubMonitor recorded
+     *
+     */
+    virtual ~BaseData() {
+        Helper::GetSubMonitor()->forget(this);
+    }
+
+    /**
+     * @brief Print the object's value to stdout. Object's type is printed with Helper::Format,
+     * specialize it to print a custom type
      */
     virtual void print(uint32_t indent_depth = 0) override{
-        for(int i = 0; i < indent_depth; i++)
-            std::cout << "  ";
-        if(name)
-            std::cout << name << ": ";
-        std::cout << value << '\n';
+        Helper::StdoutSink sink;
+        Helper::Writer writer(sink);
+        export_to(writer, indent_depth);
+    }
+
+    virtual void export_to(Helper::Writer &writer, uint32_t depth = 0) const override {
+        if (writer.get_mode() == Helper::Writer::Mode::JSON) {
+            if (depth == 0) writer.put('{');
+            writer.put_string(name ? name : "");
+            writer.put(':');
+            Helper::Format<T>::write(writer, value);
+            if (depth == 0) writer.put('}');
+        } else {
+            writer.put_indent(depth);
+            if (name) {
+                writer.put(name);
+                writer.put(": ");
+            }
+            Helper::Format<T>::write(writer, value);
+            writer.put('\n');
+        }
+    }
+
+    virtual void format_value(Helper::Writer &writer) const override {
+        Helper::Format<T>::write(writer, value);
+    }
+
+    virtual void format_encoded(Helper::Writer &writer, const uint8_t *buf, size_t buf_sz) const override {
+        T decoded;
+        if (Helper::Codec<T>::decode(decoded, buf, buf_sz)) {
+            Helper::Format<T>::write(writer, decoded);
+        } else {
+            writer.put_string("?");
+        }
     }
 
     virtual void log_on_sub(bool set = true) override{
@@ -126,6 +329,15 @@ public:
         return value;
     }
 
+    /**
+     * @brief Get the value set_default would set, without setting it
+     */
+    T get_default(void) const {
+        T next = value;
+        store_d->set_default(next);
+        return next;
+    }
+
     virtual void set_default(void) override final {
         store_d->set_default(value);
         notify(value);
@@ -137,6 +349,7 @@ public:
      */
     virtual void reset(void) override final {
         store_d->reset(value);
+        accept(value);
         notify(value);
     }
 
@@ -146,8 +359,17 @@ public:
         }
     }
 
+    virtual const char *get_nvs_key(void) const override final {
+        return store_d->get_nvs_key();
+    }
+
+    virtual Helper::NvsHandler *get_nvs_handler(void) const override final {
+        return store_d->get_nvs_handler();
+    }
+
     /**
      * @brief Use the SubscribeDelegate to subscribe to changes in the internal value
+     * @note While Helper::GetSubMonitor has a budget the callback is timed, see Helper::SubMonitor
      *
      * @param sub_cb Callback to be called when the internal value changes
      * @param immediate Whether or not to call the callback immediately
@@ -160,6 +382,31 @@ public:
         return sub_d->sub(sub_cb);
     }
 
+    /**
+     * @brief Subscribe a callback that is part of another object's bookkeeping (e.g. a
+     * FieldSubscriber's), it is never timed or demoted by Helper::GetSubMonitor
+     *
+     * @param sub_cb Callback to be called when the internal value changes
+     * @return sub_id_t id to be used to unsub
+     */
+    sub_id_t sub_internal(sub_cb_t sub_cb) {
+        return sub_d->sub(sub_cb, true);
+    }
+
+    /**
+     * @brief Use the SubscribeDelegate to subscribe with the callback run on an executor,
+     * notify only copies the value into the subscription's queue
+     *
+     * @param sub_cb Callback to be called on the executor when the internal value changes
+     * @param executor Executor (e.g. the UI task's QueueExecutor) to run the callback on
+     * @param depth Number of values that can be queued for this subscriber
+     * @param overflow What to do when the queue is full
+     * @return sub_id_t id to be used to unsub
+     */
+    virtual sub_id_t sub(sub_cb_t sub_cb, Executor &executor, size_t depth = 4, Overflow overflow = Overflow::DROP_OLDEST) final {
+        return sub_d->sub(Helper::make_queued<T>(sub_cb, executor, depth, overflow), true);
+    }
+
     /**
      * @brief Use the SubscribeDelegate to unsubscribe from changes to the internal data
      *
@@ -167,6 +414,90 @@ public:
      */
     virtual void unsub(sub_id_t sub_id) final {
         sub_d->unsub(sub_id);
+        Helper::GetSubMonitor()->forget(this, sub_id);
+    }
+
+#if __cpp_impl_coroutine
+    /**
+     * @brief Await the next change of the internal value from a coroutine
+     *
+     * @param executor Executor to resume the coroutine on, nullptr to resume inside the notify
+     * @return NextChange<T> Awaitable returning the new value
+     */
+    NextChange<T> next_change(Executor *executor = nullptr) {
+        return NextChange<T>(*this, executor);
+    }
+
+    /**
+     * @brief Subscribe to changes of the internal value so a coroutine can await them in a loop
+     *
+     * @param executor Executor to resume the coroutine on, nullptr to resume inside the notify
+     * @return Changes<T> Subscription whose next() is awaited, unsubscribes when destroyed
+     */
+    Changes<T> changes(Executor *executor = nullptr) {
+        return Changes<T>(*this, executor);
+    }
+#endif
+
+    virtual size_t sub_change(change_cb_t change_cb) override final {
+        std::shared_ptr<change_cb_t> cb = std::allocate_shared<change_cb_t>(Helper::Allocator<change_cb_t>(), change_cb);
+        return sub_d->sub([this, cb](const T &) {
+            (*cb)(*this);
+        });
+    }
+
+    virtual void unsub_change(size_t sub_id) override final {
+        sub_d->unsub(sub_id);
+        Helper::GetSubMonitor()->forget(this, sub_id);
+    }
+
+    virtual bool is_encodable(void) const override final {
+        return Helper::Codec<T>::supported;
+    }
+
+    virtual size_t encoded_size(void) const override final {
+        return Helper::Codec<T>::size(value);
+    }
+
+    virtual size_t encode(uint8_t *buf, size_t buf_sz) const override final {
+        size_t size = Helper::Codec<T>::size(value);
+        if (!Helper::Codec<T>::supported || size > buf_sz) return 0;
+        Helper::Codec<T>::encode(value, buf);
+        return size;
+    }
+
+    virtual bool decode(const uint8_t *buf, size_t buf_sz) override final {
+        T next;
+        if (!Helper::Codec<T>::decode(next, buf, buf_sz)) return false;
+        accept(next);
+        notify(next);
+        value = next;
+        store();
+        return true;
+    }
+
+    virtual bool set_encoded(const uint8_t *buf, size_t buf_sz) override {
+        T next;
+        if (!Helper::Codec<T>::decode(next, buf, buf_sz)) return false;
+        accept(next);
+        notify(next);
+        value = std::move(next);
+        return true;
+    }
+
+    /**
+     * @brief Use the StorageDelegate to store the internal value
+     *
+     */
+    virtual void store(void) override final {
+        store_d->store(*this);
+    }
+
+    /**
+     * @brief Whether or not subscribers are muted
+     */
+    virtual bool is_muted(void) const override final {
+        return muted;
     }
 
     /**
@@ -195,20 +526,18 @@ protected:
     void notify(const T &next) const {
         if(muted) return;
         if(en_logging){
-            if(name)
-                std::cout << name << ": ";
-            std::cout << value << "->" << next << '\n';
+            Helper::GetLogBuffer()->record(this, value, next);
         }
-        sub_d->notify(next);
+        sub_d->notify(next, this);
     }
 
     /**
-     * @brief Use the StorageDelegate to store the internal value
+     * @brief Called with every new value set, decoded or reset, before subscribers are
+     * notified and whether or not they are muted
      *
+     * @param next The new value
      */
-    void store(void) {
-        store_d->store(*this);
-    }
+    virtual void accept(const T &next) { }
 
     T value;
 private:
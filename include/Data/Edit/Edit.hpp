@@ -1,6 +1,7 @@
 #pragma once
 
 // Internal includes
+#include "Data/Helper/Function.hpp"
 
 // bwl component includes
 
@@ -26,7 +27,7 @@ public:
      * @param T Mutable reference to an object's internal value
      * @retval True if the objects' internal value was modified and subscribers should be updated
      */
-    using edit_cb_t = std::function<bool(T &)>;
+    using edit_cb_t = Helper::Callback<bool(T &)>;
 
     /**
      * @brief Destructor
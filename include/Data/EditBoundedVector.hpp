@@ -0,0 +1,101 @@
+#pragma once
+
+// Internal includes
+#include "EditData.hpp"
+#include "Set/SetBoundedVector.hpp"
+#include "Helper/Bounds.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+
+// Standard library includes
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Data {
+
+/**
+ * @brief EditData of a vector whose elements are kept within [min, max), every edit is
+ * checked once the callback returns
+ * @note REJECT keeps a copy of the vector from before each edit to restore, CLAMP edits
+ * in place. Elements are checked with Helper::find_out_of_bounds, vectorized for float and
+ * int32_t on hosts with SSE2/AVX2.
+ *
+ * @tparam T Type of the elements
+ * @tparam V Vector type, std::vector or a Helper::SmallVector of T
+ */
+template <typename T, typename V = std::vector<T>>
+class EditBoundedVector : public EditData<V>, public BoundedObject<T> {
+public:
+    using edit_cb_t = typename EditData<V>::edit_cb_t;
+
+    /**
+     * @brief Constructor
+     *
+     * @param sub_d Delegate to use for subscribing
+     * @param store_d Delegate to use for storing
+     * @param min Minimum valid element inclusive
+     * @param max Maximum valid element exclusive
+     * @param mode What to do with an edit that leaves elements out of bounds
+     */
+    EditBoundedVector(SubscribeDelegate<V> *sub_d, StorageDelegate<V> *store_d, const T min, const T max, BoundsMode mode, const char *name) :
+        EditData<V>(sub_d, store_d, name), min(min), max(max), mode(mode), backup(), violation(SIZE_MAX) { }
+
+    /**
+     * @brief Deleted Copy Constructor
+     *
+     */
+    EditBoundedVector(const EditBoundedVector &) = delete;
+
+    /**
+     * @brief Default Move Constructor
+     *
+     */
+    EditBoundedVector(EditBoundedVector &&) = default;
+
+    /**
+     * @brief Index of the first element out of bounds after the last edit, SIZE_MAX if
+     * every element was in bounds
+     */
+    size_t get_violation(void) const {
+        return violation;
+    }
+
+    virtual T get_min() const override final {
+        return min;
+    }
+
+    virtual T get_max() const override final {
+        return max;
+    }
+protected:
+    virtual bool apply(const edit_cb_t &edit_cb, V &value) override final {
+        if (mode == BoundsMode::REJECT) {
+            backup = value;
+        }
+        if (!edit_cb(value)) {
+            violation = SIZE_MAX;
+            return false;
+        }
+
+        size_t first = mode == BoundsMode::CLAMP ?
+            Helper::clamp_to_bounds(value.data(), value.size(), min, max) :
+            Helper::find_out_of_bounds(value.data(), value.size(), min, max);
+        violation = first < value.size() ? first : SIZE_MAX;
+        if (violation != SIZE_MAX && mode == BoundsMode::REJECT) {
+            value = backup;
+            return false;
+        }
+        return true;
+    }
+private:
+    const T min;
+    const T max;
+    const BoundsMode mode;
+    V backup;
+    size_t violation;
+};
+
+};
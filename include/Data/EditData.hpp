@@ -3,6 +3,7 @@
 // Internal includes
 #include "BaseData.hpp"
 #include "Edit/Edit.hpp"
+#include "Helper/Arena.hpp"
 
 // bwl component includes
 
@@ -11,6 +12,7 @@
 #include "FreeRTOS/semphr.h"
 
 // Standard library includes
+#include <utility>
 
 namespace Data {
 
@@ -33,7 +35,11 @@ public:
     EditData(SubscribeDelegate<T> *sub_d, StorageDelegate<T> *store_d, const char *name) :
         BaseData<T>(sub_d, store_d, name)
     {
+#if CONFIG_DATA_NO_HEAP
+        sem_h = xSemaphoreCreateBinaryStatic(&sem_buf);
+#else
         sem_h = xSemaphoreCreateBinary();
+#endif
         xSemaphoreGive(sem_h);
     }
 
@@ -44,10 +50,19 @@ public:
     EditData(const EditData<T> &) = delete;
 
     /**
-     * @brief Default Move Constructor
+     * @brief Move Constructor, the moved to object gets a semaphore of its own
      *
      */
-    EditData(EditData<T> &&) = default;
+    EditData(EditData<T> &&other) :
+        BaseData<T>(std::move(other))
+    {
+#if CONFIG_DATA_NO_HEAP
+        sem_h = xSemaphoreCreateBinaryStatic(&sem_buf);
+#else
+        sem_h = xSemaphoreCreateBinary();
+#endif
+        xSemaphoreGive(sem_h);
+    }
 
     /**
      * @brief Destructor
@@ -65,14 +80,50 @@ public:
      */
     virtual void edit(edit_cb_t edit_cb) override final {
         xSemaphoreTake(sem_h, portMAX_DELAY);
-        if (edit_cb(BaseData<T>::value)) {
+        if (apply(edit_cb, BaseData<T>::value)) {
             BaseData<T>::notify(BaseData<T>::value);
             BaseData<T>::store();
         }
         xSemaphoreGive(sem_h);
     }
+
+    /**
+     * @brief Decode a value and set it like an edit replacing the whole value, under the
+     * edit lock and checked by apply, without storing it
+     *
+     * @retval False if the value didn't decode or apply rejected it
+     */
+    virtual bool set_encoded(const uint8_t *buf, size_t buf_sz) override final {
+        T next;
+        if (!Helper::Codec<T>::decode(next, buf, buf_sz)) return false;
+        xSemaphoreTake(sem_h, portMAX_DELAY);
+        bool applied = apply([&next](T &value) {
+            value = std::move(next);
+            return true;
+        }, BaseData<T>::value);
+        if (applied) {
+            this->accept(BaseData<T>::value);
+            BaseData<T>::notify(BaseData<T>::value);
+        }
+        xSemaphoreGive(sem_h);
+        return applied;
+    }
+protected:
+    /**
+     * @brief Run an edit on the value, override to check or fix up what the edit did
+     *
+     * @param edit_cb Callback function passed to edit
+     * @param value Mutable reference of the internal value
+     * @retval True if the value was modified and subscribers should be updated
+     */
+    virtual bool apply(const edit_cb_t &edit_cb, T &value) {
+        return edit_cb(value);
+    }
 private:
     SemaphoreHandle_t sem_h;
+#if CONFIG_DATA_NO_HEAP
+    StaticSemaphore_t sem_buf;
+#endif
 };
 
 
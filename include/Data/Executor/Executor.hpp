@@ -0,0 +1,67 @@
+#pragma once
+
+// Internal includes
+
+// bwl component includes
+
+// Esp-idf component includes
+
+// Standard library includes
+
+namespace Data {
+
+/**
+ * @brief Abstract interface of something that runs work on a chosen task or thread
+ * @note Work is a plain function and argument so that posting never allocates
+ *
+ */
+class Executor {
+public:
+    /**
+     * @brief Function run by the executor
+     *
+     * @param arg The argument given to post
+     */
+    using work_fn_t = void (*)(void *arg);
+
+    /**
+     * @brief Destructor
+     *
+     */
+    virtual ~Executor() = default;
+
+    /**
+     * @brief Queue work to be run by the executor
+     *
+     * @param fn Function to run
+     * @param arg Argument to run fn with
+     * @retval True if the work was queued
+     */
+    virtual bool post(work_fn_t fn, void *arg) = 0;
+
+    /**
+     * @brief Whether or not the calling task is the one running the executor's work,
+     * waiting on the executor from it would never end
+     */
+    virtual bool is_current(void) const {
+        return false;
+    }
+};
+
+/**
+ * @brief Executor that runs work immediately on the posting task
+ *
+ */
+class InlineExecutor : public Executor {
+public:
+    virtual bool post(work_fn_t fn, void *arg) override final {
+        fn(arg);
+        return true;
+    }
+
+    virtual bool is_current(void) const override final {
+        return true;
+    }
+};
+
+};
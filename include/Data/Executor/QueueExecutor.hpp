@@ -0,0 +1,76 @@
+#pragma once
+
+// Internal includes
+#include "Executor.hpp"
+#include "Data/Helper/BoundedQueue.hpp"
+#include "Data/Helper/Arena.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+#include "FreeRTOS/FreeRTOS.h"
+#include "FreeRTOS/semphr.h"
+#include "FreeRTOS/task.h"
+
+// Standard library includes
+#include <atomic>
+
+namespace Data {
+
+/**
+ * @brief Executor whose work is run by whichever task calls run, e.g. a UI or network task
+ * @note Work is held in a bounded lock-free queue, post fails rather than blocks when it is full
+ *
+ */
+class QueueExecutor : public Executor {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param capacity Maximum number of queued work items
+     */
+    QueueExecutor(size_t capacity);
+
+    /**
+     * @brief Destructor
+     *
+     */
+    virtual ~QueueExecutor();
+
+    QueueExecutor(const QueueExecutor &) = delete;
+
+    virtual bool post(work_fn_t fn, void *arg) override final;
+
+    /**
+     * @brief Wait for work then run everything that is queued, call in a loop from the owning task
+     *
+     * @param timeout Ticks to wait for work
+     * @return size_t Number of work items run
+     */
+    size_t run(TickType_t timeout = portMAX_DELAY);
+
+    /**
+     * @brief Whether or not the calling task is the last one that called run
+     */
+    virtual bool is_current(void) const override final;
+
+    /**
+     * @brief Get the number of posts that failed because the queue was full
+     */
+    uint32_t get_dropped(void) const;
+private:
+    struct Work {
+        work_fn_t fn;
+        void *arg;
+    };
+
+    Helper::BoundedQueue<Work> queue;
+    SemaphoreHandle_t sem_h;
+#if CONFIG_DATA_NO_HEAP
+    StaticSemaphore_t sem_buf;
+#endif
+    std::atomic<uint32_t> dropped;
+    std::atomic<TaskHandle_t> runner;
+};
+
+};
@@ -0,0 +1,258 @@
+#pragma once
+
+// Internal includes
+
+// bwl component includes
+
+// Esp-idf component includes
+#include "sdkconfig.h"
+#include "FreeRTOS/FreeRTOS.h"
+#include "FreeRTOS/semphr.h"
+
+// Standard library includes
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#ifndef CONFIG_DATA_ARENA_CLASSES
+#define CONFIG_DATA_ARENA_CLASSES 32
+#endif
+
+namespace Data {
+
+namespace Helper {
+
+/**
+ * @brief Bump allocator over a caller provided buffer that keeps freed blocks for reuse
+ * @note Sizes are rounded up to whole blocks. Freed blocks of up to MAX_CLASS_SIZE go on
+ * a free list per size, larger ones on one list reused by requests of the exact same size,
+ * so subscribing and unsubscribing or regrowing to the same sizes never takes more memory.
+ *
+ */
+class Arena {
+public:
+    static constexpr size_t BLOCK = alignof(std::max_align_t) > 2 * sizeof(void *) ?
+        alignof(std::max_align_t) : 2 * sizeof(void *);                          // Granularity of the blocks
+    static constexpr size_t CLASSES = CONFIG_DATA_ARENA_CLASSES;                  // Sizes with their own free list
+    static constexpr size_t MAX_CLASS_SIZE = CLASSES * BLOCK;
+    static_assert(CLASSES > 0, "The arena needs at least one block class");
+
+    /**
+     * @brief Constructor
+     *
+     * @param buf Buffer to allocate from
+     * @param buf_sz Size of buf
+     */
+    Arena(void *buf, size_t buf_sz);
+
+    Arena(const Arena &) = delete;
+
+    ~Arena();
+
+    /**
+     * @brief Allocate memory, safe to call from several tasks
+     *
+     * @param size Number of bytes
+     * @param align Alignment, must be a power of two
+     * @return void* The memory, nullptr if the arena is exhausted
+     */
+    void *allocate(size_t size, size_t align);
+
+    /**
+     * @brief Give a block back for reuse
+     *
+     * @param memory Memory returned by allocate, may be nullptr
+     * @param size Size passed to allocate
+     */
+    void deallocate(void *memory, size_t size);
+
+    /**
+     * @brief Number of bytes taken from the buffer, including freed blocks kept for reuse
+     */
+    size_t get_used(void) const;
+
+    /**
+     * @brief Number of bytes in freed blocks kept for reuse
+     */
+    size_t get_free(void) const;
+
+    /**
+     * @brief Size of the buffer
+     */
+    size_t get_capacity(void) const;
+
+    /**
+     * @brief Size of the block holding size bytes
+     */
+    static constexpr size_t block_size(size_t size) {
+        return size == 0 ? BLOCK : (size + BLOCK - 1) / BLOCK * BLOCK;
+    }
+private:
+    void *take_free(size_t size);
+
+    struct FreeBlock {
+        FreeBlock *next;
+        size_t size;
+    };
+
+    uint8_t *buf;
+    size_t buf_sz;
+    std::atomic<size_t> pos;
+    FreeBlock *classes[CLASSES]; // Free blocks of (i + 1) * BLOCK bytes
+    FreeBlock *large;            // Free blocks over MAX_CLASS_SIZE
+    size_t free_sz;
+    SemaphoreHandle_t sem_h;     // Guards the free lists
+    StaticSemaphore_t sem_buf;
+};
+
+#if CONFIG_DATA_NO_HEAP
+/**
+ * @brief Get the arena of CONFIG_DATA_ARENA_SIZE bytes that replaces the heap
+ * for the component's own objects, made on first use from any task
+ */
+Arena *GetArena(void);
+
+/**
+ * @brief Allocate from GetArena, aborting if it is exhausted since CONFIG_DATA_ARENA_SIZE is too small
+ */
+void *arena_allocate(size_t size, size_t align);
+
+/**
+ * @brief Give memory from arena_allocate back to GetArena for reuse
+ *
+ * @param memory Memory returned by arena_allocate, may be nullptr
+ * @param size Size passed to arena_allocate
+ */
+void arena_free(void *memory, size_t size);
+#endif
+
+/**
+ * @brief Create an object for the component, from the static arena when built
+ * with CONFIG_DATA_NO_HEAP, otherwise from the heap
+ * @note In the arena the object's size is kept in a block before it, so destroy can
+ * reclaim it through a pointer to a base class
+ */
+template <typename T, typename... Args>
+T *create(Args &&... args) {
+#if CONFIG_DATA_NO_HEAP
+    static_assert(alignof(T) <= Arena::BLOCK, "Objects created in the arena can't be over aligned");
+    size_t *header = static_cast<size_t *>(arena_allocate(Arena::BLOCK + sizeof(T), Arena::BLOCK));
+    *header = Arena::BLOCK + sizeof(T);
+    return new (reinterpret_cast<uint8_t *>(header) + Arena::BLOCK) T(std::forward<Args>(args)...);
+#else
+    return new T(std::forward<Args>(args)...);
+#endif
+}
+
+/**
+ * @brief Destroy an object made with create, object may point to a base class of it
+ * if that has a virtual destructor
+ */
+template <typename T>
+void destroy(T *object) {
+#if CONFIG_DATA_NO_HEAP
+    if (object == nullptr) return;
+    uint8_t *start;
+    if constexpr (std::is_polymorphic<T>::value) {
+        // The most derived object is what create placed after the header
+        start = static_cast<uint8_t *>(dynamic_cast<void *>(object));
+    } else {
+        start = reinterpret_cast<uint8_t *>(object);
+    }
+    object->~T();
+    size_t *header = reinterpret_cast<size_t *>(start - Arena::BLOCK);
+    arena_free(header, *header);
+#else
+    delete object;
+#endif
+}
+
+/**
+ * @brief Get the single instance of a stateless object, e.g. a SetDelegate, shared
+ * by every object that uses it
+ */
+template <typename T>
+T *shared(void) {
+    static T instance;
+    return &instance;
+}
+
+/**
+ * @brief Create an array of default constructed objects, see create
+ */
+template <typename T>
+T *create_array(size_t count) {
+#if CONFIG_DATA_NO_HEAP
+    T *objects = static_cast<T *>(arena_allocate(sizeof(T) * count, alignof(T)));
+    for (size_t i = 0; i < count; i++) {
+        new (&objects[i]) T();
+    }
+    return objects;
+#else
+    return new T[count];
+#endif
+}
+
+/**
+ * @brief Destroy an array made with create_array
+ */
+template <typename T>
+void destroy_array(T *objects, size_t count) {
+#if CONFIG_DATA_NO_HEAP
+    for (size_t i = 0; objects && i < count; i++) {
+        objects[i].~T();
+    }
+    arena_free(objects, sizeof(T) * count);
+#else
+    delete[] objects;
+#endif
+}
+
+/**
+ * @brief Standard allocator using create's memory, for std::allocate_shared and containers
+ * @note In the arena every single object allocated, e.g. a shared_ptr's control block,
+ * must fit a block class so it is reused once freed
+ */
+template <typename T>
+struct Allocator {
+    using value_type = T;
+
+    Allocator(void) = default;
+
+    template <typename U>
+    Allocator(const Allocator<U> &) { }
+
+    T *allocate(size_t count) {
+#if CONFIG_DATA_NO_HEAP
+        static_assert(sizeof(T) <= Arena::MAX_CLASS_SIZE, "Object doesn't fit a block class, raise CONFIG_DATA_ARENA_CLASSES");
+        return static_cast<T *>(arena_allocate(sizeof(T) * count, alignof(T)));
+#else
+        return static_cast<T *>(::operator new(sizeof(T) * count));
+#endif
+    }
+
+    void deallocate(T *p, size_t count) {
+#if CONFIG_DATA_NO_HEAP
+        arena_free(p, sizeof(T) * count);
+#else
+        ::operator delete(p);
+#endif
+    }
+
+    template <typename U>
+    bool operator==(const Allocator<U> &) const {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const Allocator<U> &) const {
+        return false;
+    }
+};
+
+};
+
+};
@@ -0,0 +1,143 @@
+#pragma once
+
+// Internal includes
+#include "Arena.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+
+// Standard library includes
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Data {
+
+namespace Helper {
+
+/**
+ * @brief Bounded lock-free queue usable by several producers and several consumers
+ * @note Cells are allocated once in the constructor, see Helper::create. Values are copied into a cell on push
+ * and handed to the consumer in place on pop, so a cell's capacity (e.g. a vector's)
+ * is reused rather than reallocated.
+ *
+ * @tparam T Type of the elements, must be default constructible and assignable
+ */
+template <typename T>
+class BoundedQueue {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param capacity Minimum number of elements, rounded up to a power of two of at least 2
+     */
+    BoundedQueue(size_t capacity) :
+        cells(nullptr), mask(0), enqueue_pos(0), dequeue_pos(0)
+    {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        cells = create_array<Cell>(size);
+        mask = size - 1;
+        for (size_t i = 0; i < size; i++) {
+            cells[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Destructor
+     *
+     */
+    ~BoundedQueue() {
+        destroy_array(cells, mask + 1);
+    }
+
+    BoundedQueue(const BoundedQueue &) = delete;
+
+    /**
+     * @brief Add an element if there is room
+     *
+     * @param value The element to add
+     * @retval True if the element was added
+     */
+    template <typename U>
+    bool try_push(U &&value) {
+        size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+        Cell *cell;
+        while (true) {
+            cell = &cells[pos & mask];
+            size_t seq = cell->seq.load(std::memory_order_acquire);
+            intptr_t dif = (intptr_t)seq - (intptr_t)pos;
+            if (dif == 0) {
+                if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (dif < 0) {
+                return false; // Full
+            } else {
+                pos = enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = static_cast<U &&>(value);
+        cell->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Remove the oldest element, handing it to fn while its cell is held
+     *
+     * @param fn Function called with a mutable reference to the element
+     * @retval True if an element was removed
+     */
+    template <typename F>
+    bool try_pop(F &&fn) {
+        size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+        Cell *cell;
+        while (true) {
+            cell = &cells[pos & mask];
+            size_t seq = cell->seq.load(std::memory_order_acquire);
+            intptr_t dif = (intptr_t)seq - (intptr_t)(pos + 1);
+            if (dif == 0) {
+                if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (dif < 0) {
+                return false; // Empty
+            } else {
+                pos = dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        fn(cell->value);
+        cell->seq.store(pos + mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Remove the oldest element without looking at it
+     *
+     * @retval True if an element was removed
+     */
+    bool try_drop(void) {
+        return try_pop([](T &) { });
+    }
+
+    size_t capacity(void) const {
+        return mask + 1;
+    }
+private:
+    struct Cell {
+        std::atomic<size_t> seq;
+        T value;
+    };
+
+    Cell *cells;
+    size_t mask;
+    std::atomic<size_t> enqueue_pos;
+    std::atomic<size_t> dequeue_pos;
+};
+
+};
+
+};
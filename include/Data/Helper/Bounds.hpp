@@ -0,0 +1,222 @@
+#pragma once
+
+// Internal includes
+
+// bwl component includes
+
+// Esp-idf component includes
+
+// Standard library includes
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace Data {
+
+namespace Helper {
+
+/**
+ * @brief Whether or not min <= value < max, NaN is never in bounds
+ */
+template <typename T>
+inline bool in_bounds(const T &value, const T &min, const T &max) {
+    return min <= value && value < max;
+}
+
+/**
+ * @brief Find the first element outside of [min, max)
+ * @note float and int32_t use SSE2/AVX2 when the compiler targets them, i.e. on host
+ * builds, other types and targets use the scalar loop
+ *
+ * @param data Elements to check
+ * @param count Number of elements
+ * @return size_t Index of the first element out of bounds, count if there is none
+ */
+template <typename T>
+size_t find_out_of_bounds(const T *data, size_t count, T min, T max) {
+    for (size_t i = 0; i < count; i++) {
+        if (!in_bounds(data[i], min, max)) {
+            return i;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Largest value below max, the value clamp_to_bounds moves elements at or above max to
+ */
+template <typename T>
+inline T below(T max) {
+    if constexpr (std::is_floating_point<T>::value) {
+        return std::nextafter(max, -std::numeric_limits<T>::infinity());
+    } else {
+        return max - 1;
+    }
+}
+
+/**
+ * @brief Move every element outside of [min, max) to the nearest value inside it, NaN
+ * goes to min
+ * @note min must be below max
+ *
+ * @param data Elements to clamp
+ * @param count Number of elements
+ * @return size_t Index of the first element that was out of bounds, count if there was none
+ */
+template <typename T>
+size_t clamp_to_bounds(T *data, size_t count, T min, T max) {
+    size_t first = find_out_of_bounds(data, count, min, max);
+    T high = below(max);
+    for (size_t i = first; i < count; i++) {
+        if (!(min <= data[i])) {
+            data[i] = min;
+        } else if (!(data[i] < max)) {
+            data[i] = high;
+        }
+    }
+    return first;
+}
+
+#if defined(__AVX2__) || defined(__SSE2__)
+
+template <>
+inline size_t find_out_of_bounds<float>(const float *data, size_t count, float min, float max) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    __m256 min8 = _mm256_set1_ps(min);
+    __m256 max8 = _mm256_set1_ps(max);
+    for (; i + 8 <= count; i += 8) {
+        __m256 v = _mm256_loadu_ps(&data[i]);
+        __m256 in = _mm256_and_ps(_mm256_cmp_ps(v, min8, _CMP_GE_OQ), _mm256_cmp_ps(v, max8, _CMP_LT_OQ));
+        unsigned out = ~(unsigned)_mm256_movemask_ps(in) & 0xff;
+        if (out) {
+            return i + __builtin_ctz(out);
+        }
+    }
+#endif
+    __m128 min4 = _mm_set1_ps(min);
+    __m128 max4 = _mm_set1_ps(max);
+    for (; i + 4 <= count; i += 4) {
+        __m128 v = _mm_loadu_ps(&data[i]);
+        __m128 in = _mm_and_ps(_mm_cmpge_ps(v, min4), _mm_cmplt_ps(v, max4));
+        unsigned out = ~(unsigned)_mm_movemask_ps(in) & 0xf;
+        if (out) {
+            return i + __builtin_ctz(out);
+        }
+    }
+    for (; i < count; i++) {
+        if (!in_bounds(data[i], min, max)) {
+            return i;
+        }
+    }
+    return count;
+}
+
+template <>
+inline size_t find_out_of_bounds<int32_t>(const int32_t *data, size_t count, int32_t min, int32_t max) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    __m256i min8 = _mm256_set1_epi32(min);
+    __m256i max8 = _mm256_set1_epi32(max);
+    for (; i + 8 <= count; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&data[i]));
+        // In bounds is !(v < min) && v < max
+        __m256i in = _mm256_andnot_si256(_mm256_cmpgt_epi32(min8, v), _mm256_cmpgt_epi32(max8, v));
+        unsigned out = ~(unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(in)) & 0xff;
+        if (out) {
+            return i + __builtin_ctz(out);
+        }
+    }
+#endif
+    __m128i min4 = _mm_set1_epi32(min);
+    __m128i max4 = _mm_set1_epi32(max);
+    for (; i + 4 <= count; i += 4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&data[i]));
+        __m128i in = _mm_andnot_si128(_mm_cmplt_epi32(v, min4), _mm_cmplt_epi32(v, max4));
+        unsigned out = ~(unsigned)_mm_movemask_ps(_mm_castsi128_ps(in)) & 0xf;
+        if (out) {
+            return i + __builtin_ctz(out);
+        }
+    }
+    for (; i < count; i++) {
+        if (!in_bounds(data[i], min, max)) {
+            return i;
+        }
+    }
+    return count;
+}
+
+template <>
+inline size_t clamp_to_bounds<float>(float *data, size_t count, float min, float max) {
+    size_t first = find_out_of_bounds(data, count, min, max);
+    float high = below(max);
+    size_t i = first;
+    // max_ps returns its second operand when the first is NaN, so NaN goes to min
+#if defined(__AVX2__)
+    __m256 min8 = _mm256_set1_ps(min);
+    __m256 high8 = _mm256_set1_ps(high);
+    for (; i + 8 <= count; i += 8) {
+        __m256 v = _mm256_loadu_ps(&data[i]);
+        _mm256_storeu_ps(&data[i], _mm256_min_ps(_mm256_max_ps(v, min8), high8));
+    }
+#endif
+    __m128 min4 = _mm_set1_ps(min);
+    __m128 high4 = _mm_set1_ps(high);
+    for (; i + 4 <= count; i += 4) {
+        __m128 v = _mm_loadu_ps(&data[i]);
+        _mm_storeu_ps(&data[i], _mm_min_ps(_mm_max_ps(v, min4), high4));
+    }
+    for (; i < count; i++) {
+        if (!(min <= data[i])) {
+            data[i] = min;
+        } else if (!(data[i] < max)) {
+            data[i] = high;
+        }
+    }
+    return first;
+}
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+
+template <>
+inline size_t clamp_to_bounds<int32_t>(int32_t *data, size_t count, int32_t min, int32_t max) {
+    size_t first = find_out_of_bounds(data, count, min, max);
+    int32_t high = max - 1;
+    size_t i = first;
+#if defined(__AVX2__)
+    __m256i min8 = _mm256_set1_epi32(min);
+    __m256i high8 = _mm256_set1_epi32(high);
+    for (; i + 8 <= count; i += 8) {
+        __m256i *p = reinterpret_cast<__m256i *>(&data[i]);
+        _mm256_storeu_si256(p, _mm256_min_epi32(_mm256_max_epi32(_mm256_loadu_si256(p), min8), high8));
+    }
+#endif
+    __m128i min4 = _mm_set1_epi32(min);
+    __m128i high4 = _mm_set1_epi32(high);
+    for (; i + 4 <= count; i += 4) {
+        __m128i *p = reinterpret_cast<__m128i *>(&data[i]);
+        _mm_storeu_si128(p, _mm_min_epi32(_mm_max_epi32(_mm_loadu_si128(p), min4), high4));
+    }
+    for (; i < count; i++) {
+        if (data[i] < min) {
+            data[i] = min;
+        } else if (data[i] > high) {
+            data[i] = high;
+        }
+    }
+    return first;
+}
+
+#endif
+
+#endif
+
+};
+
+};
@@ -0,0 +1,185 @@
+#pragma once
+
+// Internal includes
+#include "Data/BaseData.hpp"
+#include "Function.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+
+// Standard library includes
+#include <cstdint>
+#include <functional>
+
+namespace Data {
+
+namespace Helper {
+
+/**
+ * @brief Binary layout shared by ChangeStreamEncoder and ChangeStreamDecoder
+ *
+ * A frame is a header followed by count records:
+ *   header: magic (u8), session (u32 little endian), sequence (u32 little endian), count (u16 little endian)
+ *   record: key id (varint), length (varint), value encoded with Helper::Codec
+ * The session is picked at random by each encoder, so a decoder can tell a restarted
+ * encoder (whose sequence starts over) from stale frames. The key id is the index of
+ * the object in BaseDataGeneric::for_each order, so both ends must replicate the same
+ * Model layout.
+ */
+namespace ChangeStream {
+    constexpr uint8_t FRAME_MAGIC = 0xD6;
+    constexpr size_t HEADER_SZ = 11;
+};
+
+/**
+ * @brief Subscribes to every object under a root and writes their changes out as
+ * a compact stream of frames
+ * @note Changes are coalesced, an object that changes several times between flushes
+ * is only sent once with its latest value
+ *
+ */
+class ChangeStreamEncoder {
+public:
+    /**
+     * @brief Function called with every complete frame
+     *
+     * @param frame Pointer to the frame, only valid for the duration of the call
+     * @param frame_sz Size of the frame
+     */
+    using write_cb_t = Callback<void(const uint8_t *frame, size_t frame_sz)>;
+
+    /**
+     * @brief Constructor
+     *
+     * @param root The Model (or single object) to replicate
+     * @param write_cb Function called with every complete frame
+     * @param buf Buffer frames are built in, also the largest frame that will be written,
+     * nothing is written if it can't hold ChangeStream::HEADER_SZ bytes
+     * @param buf_sz Size of buf
+     * @param flush_interval_ms Minimum time between flushes done by poll
+     */
+    ChangeStreamEncoder(BaseDataGeneric &root, write_cb_t write_cb, uint8_t *buf, size_t buf_sz, uint32_t flush_interval_ms = 0);
+
+    /**
+     * @brief Destructor, unsubscribes from every object
+     *
+     */
+    ~ChangeStreamEncoder();
+
+    ChangeStreamEncoder(const ChangeStreamEncoder &) = delete;
+
+    /**
+     * @brief Mark every object as changed so the next flush sends a full snapshot,
+     * used to bring a new mirror in sync
+     *
+     */
+    void mark_all(void);
+
+    /**
+     * @brief Flush if there are pending changes and flush_interval_ms has passed since the last flush
+     *
+     * @param now_ms Current time in milliseconds
+     * @retval True if a flush was done
+     */
+    bool poll(uint32_t now_ms);
+
+    /**
+     * @brief Write all pending changes out as one or more frames
+     *
+     */
+    void flush(void);
+
+    /**
+     * @brief Get the sequence number the next frame will use
+     */
+    uint32_t get_sequence(void) const;
+
+    /**
+     * @brief Get the session id written in every frame
+     */
+    uint32_t get_session(void) const;
+private:
+    void mark(size_t key_id);
+    void write_frame(size_t frame_sz, uint16_t count);
+
+    write_cb_t write_cb;
+    uint8_t *buf;
+    size_t buf_sz;
+    uint32_t flush_interval_ms;
+    uint32_t last_flush_ms;
+    uint32_t session;
+    uint32_t sequence;
+
+    // Sized once from the number of objects under the root, see Helper::create_array
+    size_t data_count;
+    BaseDataGeneric **datas;
+    size_t *sub_ids;
+    bool *dirty;
+    size_t *dirty_ids;
+    size_t dirty_count;
+};
+
+/**
+ * @brief Applies frames written by a ChangeStreamEncoder to every object under a root
+ *
+ */
+class ChangeStreamDecoder {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param root The Model (or single object) to apply changes to, must have the
+     * same layout as the encoder's root
+     */
+    ChangeStreamDecoder(BaseDataGeneric &root);
+
+    /**
+     * @brief Destructor
+     *
+     */
+    ~ChangeStreamDecoder();
+
+    ChangeStreamDecoder(const ChangeStreamDecoder &) = delete;
+
+    /**
+     * @brief Apply a frame, each record is decoded, notified and stored by its object
+     * @note Every record is checked before any is applied, a malformed frame changes nothing.
+     * Frames older than the last applied frame of the same session are rejected. A gap in the
+     * sequence is counted but the frame is still applied since every record carries a full value.
+     * A frame from a new session resyncs the decoder to it.
+     *
+     * @param frame Pointer to the frame
+     * @param frame_sz Size of the frame
+     * @retval True if the frame was applied
+     */
+    bool apply(const uint8_t *frame, size_t frame_sz);
+
+    /**
+     * @brief Get the sequence number expected in the next frame
+     */
+    uint32_t get_sequence(void) const;
+
+    /**
+     * @brief Get the number of frames missed, a mirror with gaps should request a mark_all
+     */
+    uint32_t get_gaps(void) const;
+
+    /**
+     * @brief Get the number of times the decoder resynced to a new session, i.e. the encoder
+     * restarted, a mirror that resynced should request a mark_all
+     */
+    uint32_t get_resyncs(void) const;
+private:
+    size_t data_count;
+    BaseDataGeneric **datas;
+    bool synced;
+    uint32_t session;
+    uint32_t sequence;
+    uint32_t gaps;
+    uint32_t resyncs;
+};
+
+};
+
+};
@@ -0,0 +1,33 @@
+#pragma once
+
+// Internal includes
+
+// bwl component includes
+
+// Esp-idf component includes
+#include "esp_timer.h"
+
+// Standard library includes
+#include <cstdint>
+
+namespace Data {
+
+namespace Helper {
+
+/**
+ * @brief Microseconds since boot
+ */
+inline int64_t now_us(void) {
+    return esp_timer_get_time();
+}
+
+/**
+ * @brief Milliseconds since boot, wraps after ~49 days so compare with subtraction
+ */
+inline uint32_t now_ms(void) {
+    return (uint32_t)(esp_timer_get_time() / 1000);
+}
+
+};
+
+};
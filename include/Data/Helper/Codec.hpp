@@ -0,0 +1,181 @@
+#pragma once
+
+// Internal includes
+#include "SmallVector.hpp"
+#include "Span.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+
+// Standard library includes
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Data {
+
+namespace Helper {
+
+/**
+ * @brief Converts values to and from a flat byte representation
+ * @note The primary template is used for types that have no byte representation,
+ * specialize it to make a custom type encodable
+ *
+ * @tparam T Type being encoded
+ */
+template <typename T, typename Enable = void>
+struct Codec {
+    static constexpr bool supported = false;
+
+    /**
+     * @brief Number of bytes needed to encode a value
+     */
+    static size_t size(const T &value) {
+        return 0;
+    }
+
+    /**
+     * @brief Encode a value into buf, buf must hold at least size(value) bytes
+     */
+    static void encode(const T &value, uint8_t *buf) { }
+
+    /**
+     * @brief Decode a value from buf
+     *
+     * @retval True if the value was decoded
+     */
+    static bool decode(T &value, const uint8_t *buf, size_t buf_sz) {
+        return false;
+    }
+};
+
+/**
+ * @brief Whether or not T is trivially copyable but has its own Codec specialization
+ */
+template <typename T>
+struct has_codec : std::false_type { };
+
+/**
+ * @brief Codec for trivially copyable types, the same layout NvsHandler stores
+ * @note Spans are trivially copyable but are encoded as the elements they view
+ */
+template <typename T>
+struct Codec<T, typename std::enable_if<std::is_trivially_copyable<T>::value && !is_span<T>::value &&
+        !has_codec<T>::value>::type> {
+    static constexpr bool supported = true;
+
+    static size_t size(const T &value) {
+        return sizeof(T);
+    }
+
+    static void encode(const T &value, uint8_t *buf) {
+        std::memcpy(buf, &value, sizeof(T));
+    }
+
+    static bool decode(T &value, const uint8_t *buf, size_t buf_sz) {
+        if (buf_sz != sizeof(T)) return false;
+        std::memcpy(&value, buf, sizeof(T));
+        return true;
+    }
+};
+
+/**
+ * @brief Codec for vectors of trivially copyable types, the same layout StorageVectorBasic stores
+ */
+template <typename T>
+struct Codec<std::vector<T>, typename std::enable_if<std::is_trivially_copyable<T>::value>::type> {
+    static constexpr bool supported = true;
+
+    static size_t size(const std::vector<T> &value) {
+        return value.size() * sizeof(T);
+    }
+
+    static void encode(const std::vector<T> &value, uint8_t *buf) {
+        if (value.size() > 0) {
+            std::memcpy(buf, &value[0], value.size() * sizeof(T));
+        }
+    }
+
+    static bool decode(std::vector<T> &value, const uint8_t *buf, size_t buf_sz) {
+        if (buf_sz % sizeof(T) != 0) return false;
+        value.resize(buf_sz / sizeof(T));
+        if (buf_sz > 0) {
+            std::memcpy(&value[0], buf, buf_sz);
+        }
+        return true;
+    }
+};
+
+/**
+ * @brief Codec for SmallVectors, the same layout as std::vector
+ */
+template <typename T, size_t N, size_t MAX>
+struct Codec<SmallVector<T, N, MAX>> {
+    static constexpr bool supported = true;
+
+    static size_t size(const SmallVector<T, N, MAX> &value) {
+        return value.size() * sizeof(T);
+    }
+
+    static void encode(const SmallVector<T, N, MAX> &value, uint8_t *buf) {
+        if (value.size() > 0) {
+            std::memcpy(buf, value.data(), value.size() * sizeof(T));
+        }
+    }
+
+    static bool decode(SmallVector<T, N, MAX> &value, const uint8_t *buf, size_t buf_sz) {
+        if (buf_sz % sizeof(T) != 0) return false;
+        return value.assign(reinterpret_cast<const T *>(buf), buf_sz / sizeof(T));
+    }
+};
+
+/**
+ * @brief Codec for read-only views, encoded like a vector of their elements
+ * @note A view can't be decoded into since it doesn't own its elements
+ */
+template <typename T>
+struct Codec<Span<const T>> {
+    static constexpr bool supported = true;
+
+    static size_t size(const Span<const T> &value) {
+        return value.size() * sizeof(T);
+    }
+
+    static void encode(const Span<const T> &value, uint8_t *buf) {
+        if (value.size() > 0) {
+            std::memcpy(buf, value.data(), value.size() * sizeof(T));
+        }
+    }
+
+    static bool decode(Span<const T> &value, const uint8_t *buf, size_t buf_sz) {
+        return false;
+    }
+};
+
+/**
+ * @brief Codec for strings, encoded without the null terminator
+ */
+template <>
+struct Codec<std::string> {
+    static constexpr bool supported = true;
+
+    static size_t size(const std::string &value) {
+        return value.size();
+    }
+
+    static void encode(const std::string &value, uint8_t *buf) {
+        std::memcpy(buf, value.data(), value.size());
+    }
+
+    static bool decode(std::string &value, const uint8_t *buf, size_t buf_sz) {
+        value.assign(reinterpret_cast<const char *>(buf), buf_sz);
+        return true;
+    }
+};
+
+};
+
+};
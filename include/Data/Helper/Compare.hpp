@@ -0,0 +1,64 @@
+#pragma once
+
+// Internal includes
+
+// bwl component includes
+
+// Esp-idf component includes
+
+// Standard library includes
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace Data {
+
+namespace Helper {
+
+/**
+ * @brief Find the first byte that differs between a and b
+ * @note Compares 16 bytes at a time with SSE2 on hosts, otherwise a machine word at a time
+ *
+ * @param a First buffer
+ * @param b Second buffer
+ * @param size Number of bytes to compare
+ * @return size_t Offset of the first differing byte, size if the buffers are equal
+ */
+inline size_t first_difference(const void *a, const void *b, size_t size) {
+    const uint8_t *pa = static_cast<const uint8_t *>(a);
+    const uint8_t *pb = static_cast<const uint8_t *>(b);
+    size_t i = 0;
+#if defined(__SSE2__)
+    for (; i + 16 <= size; i += 16) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&pa[i]));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&pb[i]));
+        unsigned diff = ~(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)) & 0xffff;
+        if (diff) {
+            return i + __builtin_ctz(diff);
+        }
+    }
+#endif
+    // memcpy keeps the word loads legal at any alignment, it compiles to a plain load
+    for (; i + sizeof(uintptr_t) <= size; i += sizeof(uintptr_t)) {
+        uintptr_t wa, wb;
+        std::memcpy(&wa, &pa[i], sizeof(wa));
+        std::memcpy(&wb, &pb[i], sizeof(wb));
+        if (wa != wb) {
+            break;
+        }
+    }
+    for (; i < size; i++) {
+        if (pa[i] != pb[i]) {
+            return i;
+        }
+    }
+    return size;
+}
+
+};
+
+};
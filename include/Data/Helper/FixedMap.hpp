@@ -0,0 +1,145 @@
+#pragma once
+
+// Internal includes
+
+// bwl component includes
+
+// Esp-idf component includes
+
+// Standard library includes
+#include <cstddef>
+#include <utility>
+
+namespace Data {
+
+namespace Helper {
+
+/**
+ * @brief Sorted map with a fixed capacity held inline, used in place of std::map
+ * when building without a heap
+ *
+ * @tparam K Key type
+ * @tparam V Value type
+ * @tparam Cmp Strict ordering of keys
+ * @tparam N Capacity
+ */
+template <typename K, typename V, typename Cmp, size_t N>
+class FixedMap {
+    static_assert(N > 0, "FixedMap capacity must be at least 1");
+public:
+    using value_type = std::pair<K, V>;
+    using iterator = value_type *;
+    using const_iterator = const value_type *;
+
+    FixedMap(void) :
+        entries(), count(0) { }
+
+    /**
+     * @brief Insert a key or replace its value
+     *
+     * @retval False if the key was new and the map is full
+     */
+    bool insert_or_assign(const K &key, const V &value) {
+        size_t i = lower_bound(key);
+        if (i < count && !Cmp()(key, entries[i].first)) {
+            entries[i].second = value;
+            return true;
+        }
+        if (count == N) {
+            return false;
+        }
+        for (size_t j = count; j > i; j--) {
+            entries[j] = entries[j - 1];
+        }
+        entries[i] = value_type(key, value);
+        count++;
+        return true;
+    }
+
+    /**
+     * @brief Remove a key
+     *
+     * @return size_t Number of entries removed
+     */
+    size_t erase(const K &key) {
+        size_t i = lower_bound(key);
+        if (i == count || Cmp()(key, entries[i].first)) {
+            return 0;
+        }
+        for (size_t j = i + 1; j < count; j++) {
+            entries[j - 1] = entries[j];
+        }
+        count--;
+        return 1;
+    }
+
+    /**
+     * @brief Find a key
+     *
+     * @return iterator The key's entry, end if the key isn't in the map
+     */
+    iterator find(const K &key) {
+        size_t i = lower_bound(key);
+        if (i == count || Cmp()(key, entries[i].first)) {
+            return end();
+        }
+        return &entries[i];
+    }
+
+    const_iterator find(const K &key) const {
+        return const_cast<FixedMap *>(this)->find(key);
+    }
+
+    iterator begin(void) {
+        return &entries[0];
+    }
+
+    iterator end(void) {
+        return &entries[count];
+    }
+
+    const_iterator begin(void) const {
+        return &entries[0];
+    }
+
+    const_iterator end(void) const {
+        return &entries[count];
+    }
+
+    void clear(void) {
+        count = 0;
+    }
+
+    size_t size(void) const {
+        return count;
+    }
+
+    bool empty(void) const {
+        return count == 0;
+    }
+
+    static constexpr size_t capacity(void) {
+        return N;
+    }
+private:
+    size_t lower_bound(const K &key) const {
+        size_t low = 0;
+        size_t high = count;
+        while (low < high) {
+            size_t mid = (low + high) / 2;
+            if (Cmp()(entries[mid].first, key)) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        return low;
+    }
+
+    value_type entries[N];
+    size_t count;
+};
+
+};
+
+};
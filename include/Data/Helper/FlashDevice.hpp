@@ -0,0 +1,70 @@
+#pragma once
+
+// Internal includes
+
+// bwl component includes
+
+// Esp-idf component includes
+#include "esp_partition.h"
+
+// Standard library includes
+#include <cstddef>
+
+namespace Data {
+
+namespace Helper {
+
+/**
+ * @brief Abstract raw flash region, erased bytes read as 0xff and programming only clears bits
+ *
+ */
+class FlashDevice {
+public:
+    /**
+     * @brief Destructor
+     *
+     */
+    virtual ~FlashDevice() = default;
+
+    virtual esp_err_t read(size_t offset, void *data, size_t data_sz) = 0;
+    virtual esp_err_t write(size_t offset, const void *data, size_t data_sz) = 0;
+
+    /**
+     * @brief Erase whole sectors, offset and size must be multiples of get_sector_size
+     */
+    virtual esp_err_t erase(size_t offset, size_t size) = 0;
+
+    virtual size_t get_size(void) const = 0;
+    virtual size_t get_sector_size(void) const = 0;
+};
+
+/**
+ * @brief FlashDevice over a data partition
+ *
+ */
+class PartitionDevice : public FlashDevice {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param label Label of the data partition, nullptr for none
+     */
+    PartitionDevice(const char *label);
+
+    /**
+     * @brief Whether or not the partition was found
+     */
+    bool is_open(void) const;
+
+    virtual esp_err_t read(size_t offset, void *data, size_t data_sz) override final;
+    virtual esp_err_t write(size_t offset, const void *data, size_t data_sz) override final;
+    virtual esp_err_t erase(size_t offset, size_t size) override final;
+    virtual size_t get_size(void) const override final;
+    virtual size_t get_sector_size(void) const override final;
+private:
+    const esp_partition_t *partition;
+};
+
+};
+
+};
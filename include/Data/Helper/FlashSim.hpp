@@ -0,0 +1,125 @@
+#pragma once
+
+// Internal includes
+#include "FlashDevice.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+
+// Standard library includes
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Data {
+
+namespace Helper {
+
+/**
+ * @brief Host-side model of a NOR flash chip with program and erase latencies and
+ * per-sector erase counters, for comparing commit strategies offline
+ * @note The simulated time only advances with flash operations. Memory comes from the
+ * heap, it is meant for host builds.
+ *
+ */
+class FlashSim : public FlashDevice {
+public:
+    /**
+     * @brief Geometry and timing of the simulated chip, defaults are typical of the
+     * SPI flash on ESP32 modules
+     *
+     */
+    struct Config {
+        size_t size;               // Bytes, a multiple of sector_sz
+        size_t page_sz;            // Bytes programmed by one program operation
+        size_t sector_sz;          // Bytes erased by one erase operation
+        uint32_t read_ns_per_byte;
+        uint32_t program_us;       // Per program page touched by a write
+        uint32_t erase_us;         // Per sector
+        uint32_t endurance;        // Erase cycles a sector is rated for
+    };
+
+    /**
+     * @brief Counters since construction or reset_stats
+     *
+     */
+    struct Stats {
+        uint64_t bytes_read;
+        uint64_t bytes_programmed;
+        uint64_t program_ops;
+        uint64_t erases;
+        uint32_t max_sector_erases; // Erases of the most worn sector
+        uint64_t time_us;           // Simulated time spent in flash operations
+        uint64_t worst_op_us;       // Longest single read, write or erase
+        uint32_t program_violations; // Writes that tried to set a cleared bit
+    };
+
+    /**
+     * @brief Get the default Config, 64KB of 4KB sectors
+     */
+    static Config default_config(void);
+
+    /**
+     * @brief Constructor, the flash starts erased
+     *
+     * @param config Geometry and timing
+     */
+    FlashSim(const Config &config = default_config());
+
+    FlashSim(const FlashSim &) = delete;
+
+    virtual esp_err_t read(size_t offset, void *data, size_t data_sz) override final;
+
+    /**
+     * @brief Program bytes, bits can only be cleared so the result is the AND of the old
+     * and new bytes
+     */
+    virtual esp_err_t write(size_t offset, const void *data, size_t data_sz) override final;
+    virtual esp_err_t erase(size_t offset, size_t size) override final;
+    virtual size_t get_size(void) const override final;
+    virtual size_t get_sector_size(void) const override final;
+
+    /**
+     * @brief Simulate a power loss after bytes more bytes are programmed, writes and
+     * erases fail from then on until restore_power
+     */
+    void cut_power_after(size_t bytes);
+    void restore_power(void);
+
+    const Config &get_config(void) const;
+    const Stats &get_stats(void) const;
+    uint32_t get_sector_erases(size_t sector) const;
+
+    /**
+     * @brief Simulated time spent in flash operations
+     */
+    uint64_t get_time_us(void) const;
+
+    /**
+     * @brief Seconds until the most worn sector reaches its endurance if the workload
+     * seen so far keeps repeating
+     *
+     * @param elapsed_s Seconds of real time the workload so far represents
+     */
+    double get_projected_lifetime(double elapsed_s) const;
+
+    /**
+     * @brief Zero the counters and sector erase counts, e.g. after setting up the
+     * contents a benchmark starts from, the flash contents are kept
+     *
+     */
+    void reset_stats(void);
+private:
+    void spend(uint64_t us);
+
+    Config config;
+    std::vector<uint8_t> mem;
+    std::vector<uint32_t> sector_erases;
+    Stats stats;
+    size_t power_budget;
+};
+
+};
+
+};
@@ -0,0 +1,168 @@
+#pragma once
+
+// Internal includes
+
+// bwl component includes
+
+// Esp-idf component includes
+#include "sdkconfig.h"
+
+// Standard library includes
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#ifndef CONFIG_DATA_CALLBACK_WORDS
+#define CONFIG_DATA_CALLBACK_WORDS 4
+#endif
+
+namespace Data {
+
+namespace Helper {
+
+template <typename Sig, size_t N>
+class InlineFunction;
+
+/**
+ * @brief Callable holding its target in N bytes of inline storage, it never allocates
+ * @note A target larger than N doesn't compile. Callbacks that wrap another callback
+ * should capture it through a shared holder, see MapData::sub_entry.
+ *
+ * @tparam R Return type
+ * @tparam Args Argument types
+ * @tparam N Bytes of inline storage
+ */
+template <typename R, typename... Args, size_t N>
+class InlineFunction<R(Args...), N> {
+public:
+    InlineFunction(void) :
+        call(nullptr), manage(nullptr) { }
+
+    InlineFunction(std::nullptr_t) :
+        call(nullptr), manage(nullptr) { }
+
+    /**
+     * @brief Construct from any callable whose captures fit the inline storage
+     *
+     */
+    template <typename F, typename D = typename std::decay<F>::type,
+            typename = typename std::enable_if<!std::is_same<D, InlineFunction>::value>::type>
+    InlineFunction(F &&fn) :
+        call(&invoke<D>), manage(&manager<D>)
+    {
+        static_assert(sizeof(D) <= N, "Callback captures don't fit, raise CONFIG_DATA_CALLBACK_WORDS");
+        static_assert(alignof(D) <= alignof(std::max_align_t), "Callback is over aligned");
+        new (storage) D(std::forward<F>(fn));
+    }
+
+    InlineFunction(const InlineFunction &other) :
+        call(other.call), manage(other.manage)
+    {
+        if (manage) manage(Op::COPY, storage, other.storage);
+    }
+
+    InlineFunction(InlineFunction &&other) :
+        call(other.call), manage(other.manage)
+    {
+        if (manage) manage(Op::MOVE, storage, other.storage);
+    }
+
+    ~InlineFunction() {
+        reset();
+    }
+
+    InlineFunction &operator=(const InlineFunction &other) {
+        if (this != &other) {
+            reset();
+            call = other.call;
+            manage = other.manage;
+            if (manage) manage(Op::COPY, storage, other.storage);
+        }
+        return *this;
+    }
+
+    InlineFunction &operator=(InlineFunction &&other) {
+        if (this != &other) {
+            reset();
+            call = other.call;
+            manage = other.manage;
+            if (manage) manage(Op::MOVE, storage, other.storage);
+        }
+        return *this;
+    }
+
+    InlineFunction &operator=(std::nullptr_t) {
+        reset();
+        return *this;
+    }
+
+    R operator()(Args... args) const {
+        return call(storage, std::forward<Args>(args)...);
+    }
+
+    explicit operator bool(void) const {
+        return call != nullptr;
+    }
+
+    bool operator==(std::nullptr_t) const {
+        return call == nullptr;
+    }
+
+    bool operator!=(std::nullptr_t) const {
+        return call != nullptr;
+    }
+private:
+    enum class Op {
+        COPY,
+        MOVE,
+        DESTROY,
+    };
+
+    using call_t = R (*)(void *target, Args &&... args);
+    using manage_t = void (*)(Op op, void *target, void *other);
+
+    template <typename D>
+    static R invoke(void *target, Args &&... args) {
+        return (*static_cast<D *>(target))(std::forward<Args>(args)...);
+    }
+
+    template <typename D>
+    static void manager(Op op, void *target, void *other) {
+        switch (op) {
+            case Op::COPY:    new (target) D(*static_cast<const D *>(other)); break;
+            case Op::MOVE:    new (target) D(std::move(*static_cast<D *>(other))); break;
+            case Op::DESTROY: static_cast<D *>(target)->~D(); break;
+        }
+    }
+
+    void reset(void) {
+        if (manage) manage(Op::DESTROY, storage, nullptr);
+        call = nullptr;
+        manage = nullptr;
+    }
+
+    call_t call;
+    manage_t manage;
+    alignas(std::max_align_t) mutable unsigned char storage[N];
+};
+
+#if CONFIG_DATA_NO_HEAP
+/**
+ * @brief Callback type used by the component, held inline in CONFIG_DATA_CALLBACK_WORDS
+ * pointers so subscribing never allocates
+ */
+template <typename Sig>
+using Callback = InlineFunction<Sig, CONFIG_DATA_CALLBACK_WORDS * sizeof(void *)>;
+#else
+/**
+ * @brief Callback type used by the component
+ */
+template <typename Sig>
+using Callback = std::function<Sig>;
+#endif
+
+};
+
+};
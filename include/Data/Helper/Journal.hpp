@@ -0,0 +1,118 @@
+#pragma once
+
+// Internal includes
+#include "FlashDevice.hpp"
+#include "Function.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+
+// Standard library includes
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace Data {
+
+namespace Helper {
+
+/**
+ * @brief Append-only log of nvs writes kept in raw flash, so a change is durable
+ * after one small append instead of a blob rewrite
+ * @note Each record is a 4 byte header (op, key length, data length), the key, the data,
+ * padding to 4 bytes and a crc of everything before it. Replay stops at the first erased
+ * or torn record. The log is erased once its records have been written to nvs.
+ *
+ */
+class Journal {
+public:
+    enum class Op : uint8_t {
+        STORE = 1, // Set the key to the record's data
+        RESET = 2, // Erase the key
+    };
+
+    using replay_cb_t = Callback<void(Op op, const char *key, const uint8_t *data, size_t data_sz)>;
+
+    /**
+     * @brief Constructor
+     *
+     * @param label Label of the data partition to keep the log in
+     */
+    Journal(const char *label);
+
+    /**
+     * @brief Constructor
+     *
+     * @param device Flash to keep the log in, e.g. a FlashSim, must outlive the journal
+     */
+    Journal(FlashDevice *device);
+
+    Journal(const Journal &) = delete;
+
+    /**
+     * @brief Whether or not there is flash to keep the log in
+     */
+    bool is_open(void) const;
+
+    /**
+     * @brief Append a record
+     *
+     * @param op What the record does
+     * @param key Nvs key, at most 15 characters
+     * @param data Data to store, nullptr for RESET
+     * @param data_sz Size of data
+     * @retval False if the log is full or the record is too large, nothing was written
+     */
+    bool append(Op op, const char *key, const void *data, size_t data_sz);
+
+    /**
+     * @brief Call cb with every intact record, oldest first, and continue appending after them
+     *
+     * @param cb Function called with each record
+     * @return size_t Number of records replayed
+     */
+    size_t replay(const replay_cb_t &cb);
+
+    /**
+     * @brief Erase the sectors holding records, the first sector last
+     * @note Stops appending until the next clear if an erase fails
+     *
+     */
+    void clear(void);
+
+    /**
+     * @brief Whether or not the log holds any records
+     */
+    bool is_empty(void) const;
+
+    /**
+     * @brief Number of bytes holding records
+     */
+    size_t get_used(void) const;
+
+    /**
+     * @brief Size of the flash the log is kept in
+     */
+    size_t get_capacity(void) const;
+private:
+    struct Header {
+        uint8_t op;
+        uint8_t key_len;
+        uint16_t data_len;
+    };
+
+    static constexpr size_t MAX_KEY_LEN = 15;
+
+    static size_t record_size(size_t key_len, size_t data_len);
+    bool check_record(size_t at, Header &header, size_t &size) const;
+
+    PartitionDevice partition;
+    FlashDevice *device;
+    size_t pos;
+    bool dirty; // Bytes past pos may have been written by a torn record
+};
+
+};
+
+};
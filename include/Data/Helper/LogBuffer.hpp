@@ -0,0 +1,116 @@
+#pragma once
+
+// Internal includes
+#include "Codec.hpp"
+#include "Writer.hpp"
+#include "Arena.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+#include "FreeRTOS/FreeRTOS.h"
+#include "FreeRTOS/semphr.h"
+
+// Standard library includes
+#include <cstdint>
+
+namespace Data {
+
+class BaseDataGeneric;
+
+namespace Helper {
+
+/**
+ * @brief Fixed size buffer of binary change records, written by objects with
+ * log_on_sub enabled and formatted later by drain
+ * @note Records that don't fit are dropped and counted rather than blocking the notify
+ *
+ */
+class LogBuffer {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param buf Buffer to hold records
+     * @param scratch Buffer drain copies the records into to format them, as large as buf
+     * @param buf_sz Size of buf
+     */
+    LogBuffer(uint8_t *buf, uint8_t *scratch, size_t buf_sz);
+
+    /**
+     * @brief Destructor
+     *
+     */
+    ~LogBuffer();
+
+    LogBuffer(const LogBuffer &) = delete;
+
+    /**
+     * @brief Record a change of an object's value using its Helper::Codec
+     *
+     * @tparam T Type of the value
+     * @param src The object that is changing, must outlive the record
+     * @param prev The current value
+     * @param next The new value
+     */
+    template <typename T>
+    void record(const BaseDataGeneric *src, const T &prev, const T &next);
+
+    /**
+     * @brief Format every record as "name: prev->next" lines (or one JSON object per line)
+     * and remove the ones written
+     * @note The records are copied out under the lock and formatted outside it, so recording
+     * isn't held up by the writer. Records from the first one the writer couldn't take in
+     * full are kept for the next drain. A drain called while another runs writes nothing.
+     *
+     * @param writer Writer to format the records with
+     */
+    void drain(Writer &writer);
+
+    /**
+     * @brief Get the number of records dropped because the buffer was full
+     */
+    uint32_t get_dropped(void) const;
+private:
+    struct Header {
+        const BaseDataGeneric *src;
+        uint16_t prev_sz;
+        uint16_t next_sz;
+    };
+
+    uint8_t *begin_record(const BaseDataGeneric *src, size_t prev_sz, size_t next_sz);
+    void end_record(void);
+
+    uint8_t *buf;
+    uint8_t *scratch;
+    size_t buf_sz;
+    size_t pos;
+    bool draining;
+    uint32_t dropped;
+    SemaphoreHandle_t sem_h;
+#if CONFIG_DATA_NO_HEAP
+    StaticSemaphore_t sem_buf;
+#endif
+};
+
+/**
+ * @brief Get the LogBuffer shared by all objects, sized by CONFIG_DATA_LOG_BUFFER_SIZE,
+ * made on first use from any task
+ */
+LogBuffer *GetLogBuffer(void);
+
+template <typename T>
+void LogBuffer::record(const BaseDataGeneric *src, const T &prev, const T &next) {
+    size_t prev_sz = Codec<T>::size(prev);
+    size_t next_sz = Codec<T>::size(next);
+    uint8_t *payload = begin_record(src, prev_sz, next_sz);
+    if (payload) {
+        Codec<T>::encode(prev, payload);
+        Codec<T>::encode(next, payload + prev_sz);
+        end_record();
+    }
+}
+
+};
+
+};
@@ -0,0 +1,111 @@
+#pragma once
+
+// Internal includes
+#include "NvsHandler.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+#include "esp_partition.h"
+
+// Standard library includes
+#include <cstddef>
+#include <cstdint>
+
+namespace Data {
+
+namespace Helper {
+
+/**
+ * @brief Read-only table of fixed size elements, memory mapped from a data partition
+ * when possible so reading it takes no RAM and no copy
+ * @note In the partition the table is a Header followed by count elements, the offset
+ * should keep the elements aligned. If mapping fails the table is copied out of the
+ * partition, and if there is no partition it is copied from an nvs blob holding just
+ * the elements (as StorageVectorBasic stores them).
+ *
+ */
+class MappedBlob {
+public:
+    /**
+     * @brief Header in front of a table in a partition
+     *
+     */
+    struct Header {
+        uint32_t magic;   // MAGIC
+        uint32_t elem_sz; // Size of one element
+        uint32_t count;   // Number of elements
+        uint32_t crc;     // esp_rom_crc32_le of the elements, checked by verify
+    };
+
+    static constexpr uint32_t MAGIC = 0x4C425444; // "DTBL"
+
+    /**
+     * @brief Constructor
+     *
+     * @param label Label of the data partition holding the table, nullptr to only use nvs
+     * @param offset Offset of the Header in the partition
+     * @param nvs_handler NvsHandler to copy the table from when there is no partition, may be nullptr
+     * @param nvs_key Nvs key of the table, may be nullptr
+     */
+    MappedBlob(const char *label, size_t offset, NvsHandler *nvs_handler, const char *nvs_key);
+
+    /**
+     * @brief Destructor, unmaps or frees the table
+     *
+     */
+    ~MappedBlob();
+
+    MappedBlob(const MappedBlob &) = delete;
+
+    /**
+     * @brief Open the table, checking the header against elem_sz and the partition's size
+     *
+     * @param elem_sz Expected size of one element
+     * @retval True if the table is available through data
+     */
+    bool open(size_t elem_sz);
+
+    /**
+     * @brief Unmap or free the table, data is no longer valid
+     *
+     */
+    void close(void);
+
+    /**
+     * @brief Check the elements against the header's crc, a full read of the table
+     * @note Tables copied from nvs are checked by nvs itself and always pass
+     */
+    bool verify(void) const;
+
+    const void *get_data(void) const;
+    size_t get_count(void) const;
+
+    /**
+     * @brief Whether or not the table is read in place rather than copied into RAM
+     */
+    bool is_mapped(void) const;
+private:
+    bool open_partition(size_t elem_sz);
+    bool open_nvs(size_t elem_sz);
+    void *allocate_copy(size_t size);
+
+    const char *label;
+    size_t offset;
+    NvsHandler *nvs_handler;
+    const char *nvs_key;
+
+    const void *data;
+    size_t count;
+    size_t elem_sz;
+    uint32_t crc;
+    bool has_crc;
+    esp_partition_mmap_handle_t mmap_handle;
+    bool mapped;
+    void *copy;
+    size_t copy_words;
+};
+
+};
+
+};
@@ -0,0 +1,95 @@
+#pragma once
+
+// Internal includes
+
+// bwl component includes
+
+// Esp-idf component includes
+#include "nvs_flash.h"
+
+// Standard library includes
+#include <cstddef>
+
+namespace Data {
+
+namespace Helper {
+
+/**
+ * @brief Abstract key value store behind an NvsHandler, following the nvs blob api
+ *
+ */
+class NvsBackend {
+public:
+    /**
+     * @brief Destructor
+     *
+     */
+    virtual ~NvsBackend() = default;
+
+    /**
+     * @brief Read a blob, as nvs_get_blob
+     *
+     * @param key The key of the blob
+     * @param data Buffer to read into, nullptr to only get the size
+     * @param data_sz Size of data, set to the size of the blob
+     */
+    virtual esp_err_t get_blob(const char *key, void *data, size_t *data_sz) = 0;
+
+    /**
+     * @brief Write a blob, as nvs_set_blob
+     */
+    virtual esp_err_t set_blob(const char *key, const void *data, size_t data_sz) = 0;
+
+    /**
+     * @brief Erase a key, as nvs_erase_key
+     */
+    virtual esp_err_t erase_key(const char *key) = 0;
+
+    /**
+     * @brief Called when the NvsHandler starts writing its dirty blocks
+     *
+     */
+    virtual void begin_commit(void) { }
+
+    /**
+     * @brief Called once the NvsHandler has written its dirty blocks, as nvs_commit
+     */
+    virtual esp_err_t commit(void) = 0;
+};
+
+/**
+ * @brief NvsBackend writing to an nvs namespace in the default nvs partition
+ *
+ */
+class NvsFlashBackend : public NvsBackend {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param nvs_name Namespace to open
+     * @param partition Label of the nvs partition to open it in, nullptr for the default
+     * partition, it must have been initialized with nvs_flash_init_partition
+     */
+    NvsFlashBackend(const char *nvs_name, const char *partition = nullptr);
+
+    /**
+     * @brief Destructor
+     *
+     */
+    virtual ~NvsFlashBackend();
+
+    NvsFlashBackend(const NvsFlashBackend &) = delete;
+
+    virtual esp_err_t get_blob(const char *key, void *data, size_t *data_sz) override final;
+    virtual esp_err_t set_blob(const char *key, const void *data, size_t data_sz) override final;
+    virtual esp_err_t erase_key(const char *key) override final;
+    virtual esp_err_t commit(void) override final;
+private:
+    const char *nvs_name;
+    const char *partition;
+    nvs_handle_t nvs_handle;
+};
+
+};
+
+};
@@ -1,15 +1,35 @@
 #pragma once
 
 // Internal includes
+#include "FixedMap.hpp"
+#include "Journal.hpp"
+#include "NvsBackend.hpp"
+#include "Writer.hpp"
+#include "Function.hpp"
 
 // bwl component includes
 
 // Esp-idf component includes
 #include "nvs_flash.h"
+#include "sdkconfig.h"
 
 // Standard library includes
+#include <cstdint>
+#include <functional>
 #include <map>
 
+#ifndef CONFIG_DATA_NVS_MAX_DIRTY
+#define CONFIG_DATA_NVS_MAX_DIRTY 32
+#endif
+
+#ifndef CONFIG_DATA_NVS_WEAR_KEYS
+#define CONFIG_DATA_NVS_WEAR_KEYS 32
+#endif
+
+#ifndef CONFIG_DATA_NVS_WEAR_WINDOW
+#define CONFIG_DATA_NVS_WEAR_WINDOW 600
+#endif
+
 namespace Data {
 
 namespace Helper {
@@ -21,6 +41,16 @@ namespace Helper {
  */
 class NvsHandler {
 public:
+    /**
+     * @brief Order dirty keys are written in, earlier classes first
+     *
+     */
+    enum class Priority : uint8_t {
+        CRITICAL, // Written by every commit slice, whatever its budget
+        NORMAL,
+        BULK,     // Large or unimportant values, the first carried over to the next slice
+    };
+
     /**
      * @brief Abstract class used to subscribe to the handlers commits
      *
@@ -34,8 +64,90 @@ public:
          * @param key The key to use for any nvs operations
          */
         virtual void commit(NvsHandler *handler, const char *key) const = 0;
+
+        /**
+         * @brief Function called to append the block's current value to the handler's
+         * journal, it must leave what the next commit writes unchanged
+         * @note Blocks that track what changed since the last commit override this, the
+         * default is commit since stateless blocks write the same either way
+         *
+         * @param handler The handler to store with, its stores go to the journal
+         * @param key The key to store under
+         */
+        virtual void journal(NvsHandler *handler, const char *key) const {
+            commit(handler, key);
+        }
+
+        /**
+         * @brief Get the order the block is written in
+         */
+        virtual Priority get_priority(void) const {
+            return Priority::NORMAL;
+        }
+
+        /**
+         * @brief Get the most milliseconds the block may stay dirty, once past it the block
+         * is written as if it were critical, 0 for no deadline
+         */
+        virtual uint32_t get_deadline_ms(void) const {
+            return 0;
+        }
     };
 
+    /**
+     * @brief Count of events over the last CONFIG_DATA_NVS_WEAR_WINDOW seconds, kept in
+     * a ring of buckets so old events age out without being stored individually
+     *
+     */
+    class RateWindow {
+    public:
+        static constexpr size_t BUCKETS = 10;
+
+        RateWindow(void);
+
+        /**
+         * @brief Count an event at time now_us
+         */
+        void add(int64_t now_us);
+
+        /**
+         * @brief Number of events within the window ending at now_us
+         */
+        uint32_t count(int64_t now_us) const;
+    private:
+        static int64_t bucket_us(void);
+
+        uint16_t buckets[BUCKETS];
+        int64_t last_epoch; // Index of the newest bucket counted since boot
+    };
+
+    /**
+     * @brief Flash writes made for a key
+     *
+     */
+    struct KeyStats {
+        uint32_t stores;       // Blobs written
+        uint32_t resets;       // Keys erased
+        uint64_t bytes;        // Bytes of blob data written
+        uint32_t commits;      // Commits that wrote the key
+        int64_t last_write_us; // Time of the last store or reset, 0 if never
+        RateWindow window;     // Stores and resets
+    };
+
+    /**
+     * @brief Counters of commits to nvs
+     *
+     */
+    struct CommitStats {
+        uint32_t commits;
+        uint32_t failed;
+        uint64_t total_us;     // Including writing the dirty blocks
+        uint64_t worst_us;
+        uint64_t last_us;
+    };
+
+    using key_stats_cb_t = Callback<void(const char *key, const KeyStats &stats)>;
+
     /**
      * @brief Constructor
      *
@@ -43,12 +155,27 @@ public:
      */
     NvsHandler(const char *nvs_name);
 
+    /**
+     * @brief Constructor
+     *
+     * @param nvs_name the name to use in logs
+     * @param backend Store to use instead of nvs, e.g. a simulator
+     * @param owns_backend Whether or not to destroy the backend with the handler, it must then
+     * be made with Helper::create, otherwise it must outlive the handler
+     */
+    NvsHandler(const char *nvs_name, NvsBackend *backend, bool owns_backend = false);
+
     /**
      * @brief Destructor
      *
      */
     ~NvsHandler();
 
+    /**
+     * @brief Get the name the handler was made with
+     */
+    const char *get_name(void) const;
+
     /**
      * @brief Returns the size of an blob stored in nvs
      *
@@ -100,11 +227,45 @@ public:
     void unsub(const char *key);
 
     /**
-     * @brief Save all subscribed objects to nvs and commit nvs
+     * @brief Save all subscribed objects to nvs and commit nvs, then clear the journal
      *
      */
     void commit(void);
 
+    /**
+     * @brief Save subscribed objects to nvs in priority order for up to budget_us and
+     * commit nvs, the objects left over stay dirty for the next slice
+     * @note Critical objects and objects past their deadline are always saved, the budget
+     * is checked after each of the others. The journal is cleared once nothing is left over.
+     *
+     * @param budget_us Microseconds to spend saving objects that aren't due
+     * @return size_t Number of objects left dirty
+     */
+    size_t commit_slice(uint32_t budget_us);
+
+    /**
+     * @brief Milliseconds until the earliest deadline of a dirty object, 0 if one is past
+     * due and UINT32_MAX if none has a deadline
+     */
+    uint32_t get_deadline_wait_ms(void) const;
+
+    /**
+     * @brief Number of objects waiting for a commit
+     */
+    size_t get_dirty_count(void) const;
+
+    /**
+     * @brief Keep a journal of changes so they are durable before the next commit
+     * @note Records left by a power loss are replayed into nvs and committed first, so
+     * call this before any values are loaded. With a journal, sub appends the object's
+     * new value straight away and commit becomes the compaction of the journal into nvs,
+     * which also happens whenever the journal fills up.
+     *
+     * @param journal Journal to use, nullptr to stop journaling
+     * @return size_t Number of records replayed
+     */
+    size_t set_journal(Journal *journal);
+
     /**
      * @brief Load a value from nvs
      *
@@ -126,16 +287,98 @@ public:
      */
     template <typename T>
     void store(const char *key, const T &value);
+
+    /**
+     * @brief Most keys that were waiting for a commit at once
+     */
+    size_t get_dirty_high_water(void) const;
+
+    /**
+     * @brief Most keys that can wait for a commit, 0 when unbounded
+     */
+    size_t get_dirty_capacity(void) const;
+
+    /**
+     * @brief Get the flash writes made for a key
+     *
+     * @param key The key to get the stats of
+     * @return const KeyStats* The key's stats, nullptr if nothing was written for the key
+     */
+    const KeyStats *get_key_stats(const char *key) const;
+
+    /**
+     * @brief Stores and resets of a key per hour over the last CONFIG_DATA_NVS_WEAR_WINDOW seconds
+     */
+    float get_write_rate(const char *key) const;
+
+    /**
+     * @brief Call cb with the stats of every key written, in key order
+     */
+    void for_each_key_stats(const key_stats_cb_t &cb) const;
+
+    /**
+     * @brief Get the counters of commits to nvs
+     */
+    const CommitStats &get_commit_stats(void) const;
+
+    /**
+     * @brief Write a key's stats, "stores=.. bytes=.." or a JSON object
+     *
+     * @param writer Writer to use
+     * @param key The key to write the stats of
+     */
+    void export_key_stats(Writer &writer, const char *key) const;
+
+    /**
+     * @brief Zero the key and commit stats
+     *
+     */
+    void reset_stats(void);
 private:
     const char *nvs_name;
-    nvs_handle_t nvs_handle;
+    NvsBackend *backend;
+    bool owns_backend;
 
     class CmpKey {
     public:
         bool operator() (const char *k1, const char *k2) const;
     };
 
-    std::map<const char *, Block*, CmpKey> subs;
+    struct Dirty {
+        Block *block;
+        int64_t due_us; // When the block must be written by, 0 for no deadline
+    };
+
+#if CONFIG_DATA_NO_HEAP
+    using subs_t = FixedMap<const char *, Dirty, CmpKey, CONFIG_DATA_NVS_MAX_DIRTY>;
+#else
+    using subs_t = std::map<const char *, Dirty, CmpKey>;
+#endif
+    struct KeyName {
+        char str[16]; // Nvs keys are at most 15 characters
+    };
+
+    class CmpName {
+    public:
+        bool operator() (const KeyName &k1, const KeyName &k2) const;
+    };
+
+#if CONFIG_DATA_NO_HEAP
+    using stats_t = FixedMap<KeyName, KeyStats, CmpName, CONFIG_DATA_NVS_WEAR_KEYS>;
+#else
+    using stats_t = std::map<KeyName, KeyStats, CmpName>;
+#endif
+
+    static KeyName make_name(const char *key);
+    KeyStats *find_or_add_stats(const char *key);
+
+    subs_t subs;
+    stats_t key_stats;
+    CommitStats commit_stats;
+    size_t dirty_high_water;
+    Journal *journal;
+    bool journaling; // store and reset append to the journal rather than writing nvs
+    bool journal_full;
 };
 
 template <typename T>
@@ -0,0 +1,129 @@
+#pragma once
+
+// Internal includes
+#include "NvsBackend.hpp"
+#include "FlashSim.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+
+// Standard library includes
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Data {
+
+namespace Helper {
+
+/**
+ * @brief Host-side NvsBackend laying blobs out on a FlashSim the way esp-idf nvs does,
+ * so the cost of a commit strategy includes nvs's own entry and garbage collection overhead
+ * @note Pages are flash sectors with a 32 byte header, a 32 byte entry state bitmap and
+ * 32 byte entries. A blob takes a header entry plus its data rounded up to entries per
+ * chunk, chunks spanning pages. A write identical to the stored blob is skipped, any
+ * other write appends new entries and marks the old ones erased. One page is kept in
+ * reserve to relocate the live entries of the oldest page before erasing it. The index
+ * lives in RAM, the sim must start from an erased device.
+ *
+ */
+class NvsSim : public NvsBackend {
+public:
+    /**
+     * @brief Counters since construction or reset_stats
+     *
+     */
+    struct Stats {
+        uint32_t sets;
+        uint32_t skipped_sets;      // Identical to the stored blob
+        uint32_t erased_keys;
+        uint32_t entries_written;   // Including header entries
+        uint32_t entries_relocated; // By garbage collection
+        uint32_t gc_count;
+        uint32_t commits;
+        uint64_t worst_commit_us;   // Simulated flash time between begin_commit and commit
+    };
+
+    /**
+     * @brief Constructor
+     *
+     * @param flash Erased flash to lay the pages out on, must outlive the sim
+     */
+    NvsSim(FlashSim *flash);
+
+    NvsSim(const NvsSim &) = delete;
+
+    virtual esp_err_t get_blob(const char *key, void *data, size_t *data_sz) override final;
+    virtual esp_err_t set_blob(const char *key, const void *data, size_t data_sz) override final;
+    virtual esp_err_t erase_key(const char *key) override final;
+    virtual void begin_commit(void) override final;
+    virtual esp_err_t commit(void) override final;
+
+    const Stats &get_stats(void) const;
+
+    /**
+     * @brief Zero the counters, call together with FlashSim::reset_stats
+     *
+     */
+    void reset_stats(void);
+
+    /**
+     * @brief Number of entries holding live blobs, including header entries
+     */
+    size_t get_live_entries(void) const;
+private:
+    static constexpr size_t ENTRY_SZ = 32;
+    static constexpr size_t PAGE_ENTRIES = 126;
+
+    enum class PageState : uint8_t {
+        EMPTY,
+        ACTIVE,
+        FULL,
+    };
+
+    struct Page {
+        PageState state;
+        uint32_t seq;        // Order the page was activated in, oldest is collected first
+        uint16_t used;       // Entries written, live or erased
+        uint16_t erased;
+    };
+
+    struct Chunk {
+        uint16_t page;
+        uint16_t entry;      // Header entry, the data follows it
+        uint16_t span;       // Entries including the header
+        uint16_t data_sz;
+    };
+
+    struct Item {
+        size_t size;
+        std::vector<Chunk> chunks;
+    };
+
+    size_t entry_offset(uint16_t page, uint16_t entry) const;
+    void set_state(uint16_t page, uint16_t entry, uint16_t span, uint8_t state);
+    void write_page_header(uint16_t page);
+    esp_err_t activate_page(void);
+    esp_err_t collect(void);
+    esp_err_t write_chunk(const char *key, const uint8_t *data, size_t data_sz, Chunk &chunk);
+    esp_err_t write_item(const char *key, const uint8_t *data, size_t data_sz, Item &item);
+    void erase_item(const Item &item);
+    bool matches(const Item &item, const uint8_t *data, size_t data_sz);
+    esp_err_t read_item(const Item &item, uint8_t *data);
+
+    FlashSim *flash;
+    std::vector<Page> pages;
+    std::map<std::string, Item> items;
+    int active;       // Page entries are appended to, -1 for none
+    uint32_t next_seq;
+    size_t live_entries;
+    uint64_t commit_start_us;
+    Stats stats;
+};
+
+};
+
+};
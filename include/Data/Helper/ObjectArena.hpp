@@ -0,0 +1,116 @@
+#pragma once
+
+// Internal includes
+#include "Arena.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+
+// Standard library includes
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Data {
+
+namespace Helper {
+
+/**
+ * @brief Bump allocator that owns the objects it creates, destroying them in reverse
+ * order of creation when it is cleared or destroyed
+ * @note Memory is taken in chunks from create's memory, so objects made together sit together.
+ * Not safe to use from several tasks at once, objects are expected to be made while
+ * their Model is being constructed.
+ *
+ */
+class ObjectArena {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param chunk_sz Bytes taken at a time, larger requests get a chunk of their own
+     */
+    ObjectArena(size_t chunk_sz = 1024);
+
+    /**
+     * @brief Destructor, destroys every object created
+     *
+     */
+    ~ObjectArena();
+
+    ObjectArena(const ObjectArena &) = delete;
+
+    /**
+     * @brief Allocate memory that lives until the arena is cleared
+     *
+     * @param size Number of bytes
+     * @param align Alignment, must be a power of two no larger than alignof(std::max_align_t)
+     */
+    void *allocate(size_t size, size_t align);
+
+    /**
+     * @brief Create an object owned by the arena
+     *
+     * @tparam T Type of the object
+     * @param args Arguments to T's constructor
+     */
+    template <typename T, typename... Args>
+    T *create(Args &&... args);
+
+    /**
+     * @brief Destroy every object in reverse order of creation and release the chunks
+     *
+     */
+    void clear(void);
+
+    /**
+     * @brief Number of bytes handed out, including padding and destructor records
+     */
+    size_t get_used(void) const;
+
+    /**
+     * @brief Number of bytes taken in chunks
+     */
+    size_t get_reserved(void) const;
+private:
+    struct Chunk {
+        Chunk *next;
+        size_t size;
+    };
+
+    struct Cleanup {
+        Cleanup *next;
+        void (*destroy)(void *);
+        void *object;
+    };
+
+    Chunk *chunks;
+    uint8_t *pos;
+    uint8_t *end;
+    Cleanup *cleanups;
+    size_t chunk_sz;
+    size_t used;
+    size_t reserved;
+};
+
+template <typename T, typename... Args>
+T *ObjectArena::create(Args &&... args) {
+    T *object = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    if (!std::is_trivially_destructible<T>::value) {
+        Cleanup *cleanup = static_cast<Cleanup *>(allocate(sizeof(Cleanup), alignof(Cleanup)));
+        cleanup->next = cleanups;
+        cleanup->destroy = [](void *p) {
+            static_cast<T *>(p)->~T();
+        };
+        cleanup->object = object;
+        cleanups = cleanup;
+    }
+    return object;
+}
+
+};
+
+};
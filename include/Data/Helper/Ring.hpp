@@ -0,0 +1,115 @@
+#pragma once
+
+// Internal includes
+
+// bwl component includes
+
+// Esp-idf component includes
+
+// Standard library includes
+#include <cstddef>
+
+namespace Data {
+
+namespace Helper {
+
+/**
+ * @brief Fixed capacity ring that overwrites its oldest element when full
+ *
+ * @tparam T Type of the elements
+ * @tparam N Capacity
+ */
+template <typename T, size_t N>
+class Ring {
+    static_assert(N > 0, "Ring capacity must be at least 1");
+public:
+    Ring(void) :
+        slots(), head(0), count(0) { }
+
+    /**
+     * @brief Add an element, overwriting the oldest one if the ring is full
+     *
+     * @param value The element to add
+     * @return size_t The slot the element was written to
+     */
+    size_t push(const T &value) {
+        size_t slot = head;
+        slots[slot] = value;
+        head = (head + 1) % N;
+        if (count < N) {
+            count++;
+        }
+        return slot;
+    }
+
+    /**
+     * @brief Get an element, 0 is the oldest and size() - 1 the newest
+     */
+    const T &operator[](size_t i) const {
+        return slots[(head + N - count + i) % N];
+    }
+
+    /**
+     * @brief Get the newest element, the ring must not be empty
+     */
+    const T &back(void) const {
+        return slots[(head + N - 1) % N];
+    }
+
+    size_t size(void) const {
+        return count;
+    }
+
+    bool empty(void) const {
+        return count == 0;
+    }
+
+    static constexpr size_t capacity(void) {
+        return N;
+    }
+
+    void clear(void) {
+        head = 0;
+        count = 0;
+    }
+
+    /**
+     * @brief Get the underlying slots, used to persist the ring as is
+     */
+    T *get_slots(void) {
+        return slots;
+    }
+
+    const T *get_slots(void) const {
+        return slots;
+    }
+
+    /**
+     * @brief Get the slot the next push will write to
+     */
+    size_t get_head(void) const {
+        return head;
+    }
+
+    /**
+     * @brief Restore the position of a ring whose slots were loaded with get_slots
+     *
+     * @retval True if head and count were valid
+     */
+    bool restore(size_t head, size_t count) {
+        if (head >= N || count > N) {
+            return false;
+        }
+        this->head = head;
+        this->count = count;
+        return true;
+    }
+private:
+    T slots[N];
+    size_t head;
+    size_t count;
+};
+
+};
+
+};
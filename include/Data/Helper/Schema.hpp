@@ -0,0 +1,130 @@
+#pragma once
+
+// Internal includes
+#include "NvsHandler.hpp"
+#include "Span.hpp"
+#include "Function.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+#include "sdkconfig.h"
+
+// Standard library includes
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#ifndef CONFIG_DATA_MIGRATE_MAX_SIZE
+#define CONFIG_DATA_MIGRATE_MAX_SIZE 512
+#endif
+
+namespace Data {
+
+namespace Helper {
+
+/**
+ * @brief Header stored in front of each versioned blob
+ *
+ */
+struct BlobHeader {
+    static constexpr uint16_t MAGIC = 0xDA7A;
+
+    uint16_t magic;
+    uint16_t version;
+    uint32_t size;      // Bytes following the header
+
+    bool operator==(const BlobHeader &other) const {
+        return magic == other.magic && version == other.version && size == other.size;
+    }
+
+    bool operator!=(const BlobHeader &other) const {
+        return !(*this == other);
+    }
+};
+
+/**
+ * @brief Converts a value stored by an older layout into the current one
+ *
+ * @tparam T Current type of the value
+ */
+template <typename T>
+struct Migration {
+    uint16_t from;  // Version the migration reads, 0 for blobs stored without a header
+    /**
+     * @brief Fill value from the old bytes, value holds the default beforehand so only
+     * the members the old layout had need copying
+     *
+     * @retval False if the old bytes can't be migrated, the value is then reset
+     */
+    bool (*migrate)(const uint8_t *old, size_t old_sz, T &value);
+};
+
+/**
+ * @brief Version of a value's layout and the migrations from its older versions
+ * @note Each migration goes straight to the current layout, so a value several
+ * versions behind is converted once. Versions start at 1, 0 is left for blobs stored
+ * by StorageBasic before the value was versioned.
+ *
+ * @tparam T Current type of the value
+ */
+template <typename T>
+struct Schema {
+    Schema(uint16_t version) :
+        version(version), migrations() { }
+
+    /**
+     * @brief Constructor
+     *
+     * @param version Version of T's layout, bumped every time it changes
+     * @param migrations Migrations from older versions, must outlive the Schema
+     */
+    template <size_t N>
+    Schema(uint16_t version, const Migration<T> (&migrations)[N]) :
+        version(version), migrations(migrations, N) { }
+
+    /**
+     * @brief Find the migration from a version
+     *
+     * @return const Migration<T>* The migration, nullptr if there is none
+     */
+    const Migration<T> *find(uint16_t from) const {
+        for (const Migration<T> &migration : migrations) {
+            if (migration.from == from) {
+                return &migration;
+            }
+        }
+        return nullptr;
+    }
+
+    uint16_t version;
+    Span<const Migration<T>> migrations;
+};
+
+/**
+ * @brief A value stored after its header, as one blob
+ *
+ */
+template <typename T>
+struct VersionedBlob {
+    BlobHeader header;
+    T value;
+};
+
+using blob_cb_t = Callback<bool(uint16_t version, const uint8_t *data, size_t data_sz)>;
+
+/**
+ * @brief Read a blob of any version and size, the slow path of a versioned load
+ * @note Blobs without a valid header are passed whole as version 0. Built with
+ * CONFIG_DATA_NO_HEAP, blobs over CONFIG_DATA_MIGRATE_MAX_SIZE bytes can't be read.
+ *
+ * @param handler Handler the blob is stored with
+ * @param key Nvs key of the blob
+ * @param blob_cb Callback called with the blob's version and the bytes after its header
+ * @retval False if the blob is missing, unreadable or blob_cb returned false
+ */
+bool read_blob(NvsHandler &handler, const char *key, const blob_cb_t &blob_cb);
+
+};
+
+};
@@ -0,0 +1,272 @@
+#pragma once
+
+// Internal includes
+#include "Arena.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+
+// Standard library includes
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <type_traits>
+
+namespace Data {
+
+namespace Helper {
+
+/**
+ * @brief Vector holding up to N elements inline, only allocating (see Allocator) when it grows past N
+ * @note Elements are moved with memcpy so they must be trivially copyable, like the
+ * elements StorageVectorBasic stores
+ *
+ * @tparam T Type of the elements
+ * @tparam N Number of elements held inline
+ * @tparam MAX Hard maximum number of elements, 0 for no maximum. When MAX <= N the
+ * vector never allocates.
+ */
+template <typename T, size_t N, size_t MAX = 0>
+class SmallVector {
+    static_assert(std::is_trivially_copyable<T>::value, "SmallVector elements must be trivially copyable");
+    static_assert(N > 0, "SmallVector must hold at least one element inline");
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using iterator = T *;
+    using const_iterator = const T *;
+
+    SmallVector(void) :
+        ptr(inline_data()), count(0), cap(N) { }
+
+    SmallVector(std::initializer_list<T> values) :
+        SmallVector()
+    {
+        assign(values.begin(), values.size());
+    }
+
+    SmallVector(const SmallVector &other) :
+        SmallVector()
+    {
+        assign(other.data(), other.size());
+    }
+
+    SmallVector &operator=(const SmallVector &other) {
+        if (this != &other) {
+            assign(other.data(), other.size());
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Move Constructor, takes other's allocation or copies its inline elements,
+     * other is left empty
+     *
+     */
+    SmallVector(SmallVector &&other) :
+        SmallVector()
+    {
+        take(other);
+    }
+
+    SmallVector &operator=(SmallVector &&other) {
+        if (this != &other) {
+            release();
+            ptr = inline_data();
+            cap = N;
+            take(other);
+        }
+        return *this;
+    }
+
+    ~SmallVector() {
+        release();
+    }
+
+    /**
+     * @brief Replace the contents with count elements copied from values
+     *
+     * @retval False if count is over max_size, the contents are unchanged
+     */
+    bool assign(const T *values, size_t count) {
+        if (!reserve(count)) return false;
+        if (count > 0) {
+            std::memmove(ptr, values, count * sizeof(T));
+        }
+        this->count = count;
+        return true;
+    }
+
+    /**
+     * @brief Make room for at least new_cap elements
+     *
+     * @retval False if new_cap is over max_size
+     */
+    bool reserve(size_t new_cap) {
+        if (new_cap > max_size()) return false;
+        if (new_cap <= cap) return true;
+
+        size_t grown = cap * 2 > new_cap ? cap * 2 : new_cap;
+        if (grown > max_size()) grown = max_size();
+        T *grown_ptr = Allocator<T>().allocate(grown);
+        if (count > 0) {
+            std::memcpy(grown_ptr, ptr, count * sizeof(T));
+        }
+        release();
+        ptr = grown_ptr;
+        cap = grown;
+        return true;
+    }
+
+    /**
+     * @brief Change the number of elements, new elements are value initialized
+     *
+     * @retval False if new_size is over max_size, the contents are unchanged
+     */
+    bool resize(size_t new_size) {
+        if (!reserve(new_size)) return false;
+        for (size_t i = count; i < new_size; i++) {
+            ptr[i] = T();
+        }
+        count = new_size;
+        return true;
+    }
+
+    /**
+     * @brief Add an element to the end
+     *
+     * @retval False if the vector is at max_size
+     */
+    bool push_back(const T &value) {
+        if (count >= max_size()) {
+            return false;
+        } else if (count == cap) {
+            T copy = value; // value may be inside the storage being grown
+            if (!reserve(count + 1)) return false;
+            ptr[count++] = copy;
+        } else {
+            ptr[count++] = value;
+        }
+        return true;
+    }
+
+    void pop_back(void) {
+        if (count > 0) count--;
+    }
+
+    /**
+     * @brief Remove the element at pos, moving the ones after it down
+     */
+    iterator erase(const_iterator pos) {
+        size_t index = pos - ptr;
+        if (index < count) {
+            std::memmove(&ptr[index], &ptr[index + 1], (count - index - 1) * sizeof(T));
+            count--;
+        }
+        return &ptr[index];
+    }
+
+    void clear(void) {
+        count = 0;
+    }
+
+    /**
+     * @brief Go back to the inline storage if the elements fit in it
+     */
+    void shrink_to_fit(void) {
+        if (ptr != inline_data() && count <= N) {
+            T *heap_ptr = ptr;
+            size_t heap_cap = cap;
+            ptr = inline_data();
+            cap = N;
+            if (count > 0) {
+                std::memcpy(ptr, heap_ptr, count * sizeof(T));
+            }
+            Allocator<T>().deallocate(heap_ptr, heap_cap);
+        }
+    }
+
+    T &operator[](size_t i) { return ptr[i]; }
+    const T &operator[](size_t i) const { return ptr[i]; }
+    T &back(void) { return ptr[count - 1]; }
+    const T &back(void) const { return ptr[count - 1]; }
+    T *data(void) { return ptr; }
+    const T *data(void) const { return ptr; }
+    iterator begin(void) { return ptr; }
+    iterator end(void) { return ptr + count; }
+    const_iterator begin(void) const { return ptr; }
+    const_iterator end(void) const { return ptr + count; }
+    size_t size(void) const { return count; }
+    bool empty(void) const { return count == 0; }
+    size_t capacity(void) const { return cap; }
+
+    /**
+     * @brief Whether or not the elements are held inline
+     */
+    bool is_inline(void) const {
+        return ptr == inline_data();
+    }
+
+    /**
+     * @brief Most elements the vector can hold, MAX if it has one
+     */
+    static constexpr size_t max_size(void) {
+        return MAX > 0 ? MAX : SIZE_MAX / sizeof(T);
+    }
+
+    bool operator==(const SmallVector &other) const {
+        if (count != other.count) return false;
+        for (size_t i = 0; i < count; i++) {
+            if (!(ptr[i] == other.ptr[i])) return false;
+        }
+        return true;
+    }
+
+    bool operator!=(const SmallVector &other) const {
+        return !(*this == other);
+    }
+private:
+    T *inline_data(void) {
+        return reinterpret_cast<T *>(storage);
+    }
+
+    const T *inline_data(void) const {
+        return reinterpret_cast<const T *>(storage);
+    }
+
+    void release(void) {
+        if (ptr != inline_data()) {
+            Allocator<T>().deallocate(ptr, cap);
+        }
+    }
+
+    /**
+     * @brief Move other's elements into this empty inline vector and leave other empty
+     *
+     */
+    void take(SmallVector &other) {
+        if (other.is_inline()) {
+            if (other.count > 0) {
+                std::memcpy(ptr, other.ptr, other.count * sizeof(T));
+            }
+        } else {
+            ptr = other.ptr;
+            cap = other.cap;
+            other.ptr = other.inline_data();
+            other.cap = N;
+        }
+        count = other.count;
+        other.count = 0;
+    }
+
+    alignas(T) unsigned char storage[N * sizeof(T)];
+    T *ptr;
+    size_t count;
+    size_t cap;
+};
+
+};
+
+};
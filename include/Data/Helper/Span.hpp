@@ -0,0 +1,67 @@
+#pragma once
+
+// Internal includes
+
+// bwl component includes
+
+// Esp-idf component includes
+
+// Standard library includes
+#include <cstddef>
+#include <type_traits>
+
+namespace Data {
+
+namespace Helper {
+
+/**
+ * @brief Non-owning view of count contiguous elements
+ *
+ * @tparam T Type of the elements, const for read-only views
+ */
+template <typename T>
+class Span {
+public:
+    using value_type = T;
+    using iterator = T *;
+
+    Span(void) :
+        ptr(nullptr), count(0) { }
+
+    Span(T *ptr, size_t count) :
+        ptr(ptr), count(count) { }
+
+    T &operator[](size_t i) const { return ptr[i]; }
+    T *data(void) const { return ptr; }
+    iterator begin(void) const { return ptr; }
+    iterator end(void) const { return ptr + count; }
+    size_t size(void) const { return count; }
+    bool empty(void) const { return count == 0; }
+
+    /**
+     * @brief Spans are equal when they view the same elements, the elements aren't compared
+     */
+    bool operator==(const Span &other) const {
+        return ptr == other.ptr && count == other.count;
+    }
+
+    bool operator!=(const Span &other) const {
+        return !(*this == other);
+    }
+private:
+    T *ptr;
+    size_t count;
+};
+
+/**
+ * @brief Whether or not T is a Span
+ */
+template <typename T>
+struct is_span : std::false_type { };
+
+template <typename T>
+struct is_span<Span<T>> : std::true_type { };
+
+};
+
+};
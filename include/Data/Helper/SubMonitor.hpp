@@ -0,0 +1,164 @@
+#pragma once
+
+// Internal includes
+#include "Writer.hpp"
+#include "Function.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+#include "FreeRTOS/FreeRTOS.h"
+#include "FreeRTOS/semphr.h"
+#include "sdkconfig.h"
+
+// Standard library includes
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#ifndef CONFIG_DATA_SUB_MONITOR_SIZE
+#define CONFIG_DATA_SUB_MONITOR_SIZE 8
+#endif
+
+#ifndef CONFIG_DATA_SUB_BUDGET_US
+#define CONFIG_DATA_SUB_BUDGET_US 0
+#endif
+
+namespace Data {
+
+class BaseDataGeneric;
+class Executor;
+
+namespace Helper {
+
+/**
+ * @brief Records subscriber callbacks that ran longer than a budget inside a notify,
+ * and optionally has repeat offenders moved onto an executor
+ * @note While a budget is set, the notify of SubscribeBasic and SubscribeStatic times
+ * each subscriber with Helper::now_us around its call. Subscriptions that are part of the
+ * library's own bookkeeping (BaseData::sub_internal, queued subscriptions) are never
+ * timed. Offenders past the table's CONFIG_DATA_SUB_MONITOR_SIZE entries are only counted.
+ *
+ */
+class SubMonitor {
+public:
+    static constexpr size_t NAME_SZ = 24;
+
+    /**
+     * @brief A subscriber that exceeded the budget
+     * @note Offenders are forgotten when they unsubscribe or their object is destroyed,
+     * so src stays valid and a reused sub id starts over
+     *
+     */
+    struct Offender {
+        const BaseDataGeneric *src; // Object the subscriber is subscribed to
+        size_t sub_id;              // Id returned by the object's sub
+        char name[NAME_SZ];         // Object's name when first recorded, cut to fit
+        uint32_t count;             // Calls over the budget
+        uint32_t last_us;           // Duration of the latest call over the budget
+        uint32_t worst_us;
+        bool demoted;               // Delivered on the demotion executor since
+    };
+
+    using offender_cb_t = Callback<void(const Offender &offender)>;
+
+    /**
+     * @brief Constructor, the budget starts as CONFIG_DATA_SUB_BUDGET_US
+     *
+     */
+    SubMonitor(void);
+
+    /**
+     * @brief Destructor
+     *
+     */
+    ~SubMonitor();
+
+    SubMonitor(const SubMonitor &) = delete;
+
+    /**
+     * @brief Set the longest a callback may run, 0 to stop timing callbacks
+     */
+    void set_budget_us(uint32_t budget_us);
+
+    uint32_t get_budget_us(void) const;
+
+    /**
+     * @brief Move subscribers onto an executor once they went over the budget after times
+     *
+     * @param executor Executor to run demoted callbacks on, nullptr to never demote
+     * @param after Offenses before a subscriber is demoted
+     */
+    void set_demotion(Executor *executor, uint32_t after = 3);
+
+    Executor *get_demotion_executor(void) const;
+
+    /**
+     * @brief Record a call over the budget, called from the notify
+     *
+     * @param src Object the subscriber is subscribed to
+     * @param sub_id Id of the subscriber
+     * @param us Duration of the call
+     * @return Executor* Executor to demote the subscriber onto, nullptr to keep it
+     */
+    Executor *record(const BaseDataGeneric *src, size_t sub_id, uint32_t us);
+
+    /**
+     * @brief Forget a subscriber, called when it unsubscribes since its id can be reused
+     *
+     * @param src Object the subscriber was subscribed to
+     * @param sub_id Id of the subscriber
+     */
+    void forget(const BaseDataGeneric *src, size_t sub_id);
+
+    /**
+     * @brief Forget every subscriber of an object, called when the object is destroyed
+     *
+     * @param src Object being destroyed
+     */
+    void forget(const BaseDataGeneric *src);
+
+    /**
+     * @brief Call cb with every offender recorded
+     */
+    void for_each_offender(const offender_cb_t &cb) const;
+
+    /**
+     * @brief Write "name#id: count=.. worst_us=.." lines or a JSON array of the offenders
+     */
+    void export_to(Writer &writer) const;
+
+    /**
+     * @brief Forget the offenders, demoted subscribers stay demoted
+     *
+     */
+    void clear(void);
+
+    /**
+     * @brief Get the number of offenses not recorded because the table was full
+     */
+    uint32_t get_dropped(void) const;
+private:
+    void remove(const BaseDataGeneric *src, bool any_id, size_t sub_id);
+
+    std::atomic<uint32_t> budget_us;
+    Executor *executor;
+    uint32_t demote_after;
+    Offender offenders[CONFIG_DATA_SUB_MONITOR_SIZE];
+    size_t count;
+    uint32_t dropped;
+    SemaphoreHandle_t sem_h;
+#if CONFIG_DATA_NO_HEAP
+    StaticSemaphore_t sem_buf;
+#endif
+};
+
+/**
+ * @brief Get the SubMonitor shared by all objects, it is created before main
+ */
+SubMonitor *GetSubMonitor(void);
+
+};
+
+};
@@ -0,0 +1,260 @@
+#pragma once
+
+// Internal includes
+#include "SmallVector.hpp"
+#include "Span.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+
+// Standard library includes
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Data {
+
+namespace Helper {
+
+/**
+ * @brief Abstract destination for formatted text
+ *
+ */
+class Sink {
+public:
+    /**
+     * @brief Destructor
+     *
+     */
+    virtual ~Sink() = default;
+
+    /**
+     * @brief Write bytes to the sink
+     *
+     * @param data Pointer to the bytes to write
+     * @param data_sz Number of bytes to write
+     * @return size_t Number of bytes accepted, less than data_sz when the sink is full
+     */
+    virtual size_t write(const char *data, size_t data_sz) = 0;
+};
+
+/**
+ * @brief Sink that fills a caller provided fixed buffer
+ *
+ */
+class BufferSink : public Sink {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param buf Buffer to write into
+     * @param buf_sz Size of buf
+     */
+    BufferSink(char *buf, size_t buf_sz);
+
+    virtual size_t write(const char *data, size_t data_sz) override final;
+
+    /**
+     * @brief Number of bytes written into the buffer
+     */
+    size_t size(void) const;
+private:
+    char *buf;
+    size_t buf_sz;
+    size_t pos;
+};
+
+/**
+ * @brief Sink that writes to stdout in small blocks, without iostream
+ *
+ */
+class StdoutSink : public Sink {
+public:
+    StdoutSink(void);
+
+    /**
+     * @brief Destructor, flushes anything still buffered
+     *
+     */
+    virtual ~StdoutSink();
+
+    virtual size_t write(const char *data, size_t data_sz) override final;
+private:
+    char buf[64];
+    size_t pos;
+};
+
+/**
+ * @brief Formats values as plain text or JSON into a Sink without allocating
+ * @note Bytes before skip are produced but not written, allowing a large export to
+ * be resumed chunk by chunk into a small buffer
+ *
+ */
+class Writer {
+public:
+    enum class Mode {
+        TEXT,
+        JSON,
+    };
+
+    /**
+     * @brief Constructor
+     *
+     * @param sink Sink to write to
+     * @param mode Plain text or JSON
+     * @param skip Number of leading bytes to produce but not write
+     */
+    Writer(Sink &sink, Mode mode = Mode::TEXT, size_t skip = 0);
+
+    Mode get_mode(void) const;
+
+    /**
+     * @brief Whether or not the sink stopped accepting bytes
+     */
+    bool is_full(void) const;
+
+    /**
+     * @brief Total number of bytes produced, including skipped ones
+     */
+    size_t get_produced(void) const;
+
+    void put(const char *data, size_t data_sz);
+    void put(const char *str);
+    void put(char c);
+    void put_uint(uint64_t value);
+    void put_int(int64_t value);
+    void put_float(double value);
+    void put_bool(bool value);
+
+    /**
+     * @brief Write a string, quoted and escaped in JSON mode
+     */
+    void put_string(const char *str, size_t str_sz);
+    void put_string(const char *str);
+
+    /**
+     * @brief Write bytes as hex, quoted in JSON mode
+     */
+    void put_hex(const void *data, size_t data_sz);
+
+    /**
+     * @brief Write two spaces per depth, only in text mode
+     */
+    void put_indent(uint32_t depth);
+private:
+    Sink &sink;
+    Mode mode;
+    size_t skip;
+    size_t produced;
+    bool full;
+};
+
+/**
+ * @brief Type dispatched formatting of a value through a Writer
+ * @note Specialize this to give a custom type a readable format, otherwise trivially
+ * copyable types are written as hex
+ *
+ * @tparam T Type being formatted
+ */
+template <typename T, typename Enable = void>
+struct Format {
+    static void write(Writer &writer, const T &value) {
+        if constexpr (std::is_trivially_copyable<T>::value) {
+            writer.put_hex(&value, sizeof(T));
+        } else {
+            writer.put_string("?");
+        }
+    }
+};
+
+template <>
+struct Format<bool> {
+    static void write(Writer &writer, const bool &value) {
+        writer.put_bool(value);
+    }
+};
+
+template <typename T>
+struct Format<T, typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type> {
+    static void write(Writer &writer, const T &value) {
+        writer.put_int(value);
+    }
+};
+
+template <typename T>
+struct Format<T, typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value>::type> {
+    static void write(Writer &writer, const T &value) {
+        writer.put_uint(value);
+    }
+};
+
+template <typename T>
+struct Format<T, typename std::enable_if<std::is_enum<T>::value>::type> {
+    static void write(Writer &writer, const T &value) {
+        writer.put_int((int64_t)value);
+    }
+};
+
+template <typename T>
+struct Format<T, typename std::enable_if<std::is_floating_point<T>::value>::type> {
+    static void write(Writer &writer, const T &value) {
+        writer.put_float(value);
+    }
+};
+
+template <>
+struct Format<std::string> {
+    static void write(Writer &writer, const std::string &value) {
+        writer.put_string(value.data(), value.size());
+    }
+};
+
+template <>
+struct Format<const char *> {
+    static void write(Writer &writer, const char *const &value) {
+        writer.put_string(value ? value : "");
+    }
+};
+
+template <typename T>
+struct Format<std::vector<T>> {
+    static void write(Writer &writer, const std::vector<T> &value) {
+        writer.put('[');
+        for (size_t i = 0; i < value.size() && !writer.is_full(); i++) {
+            if (i > 0) writer.put(',');
+            Format<T>::write(writer, value[i]);
+        }
+        writer.put(']');
+    }
+};
+
+template <typename T>
+struct Format<Span<const T>> {
+    static void write(Writer &writer, const Span<const T> &value) {
+        writer.put('[');
+        for (size_t i = 0; i < value.size() && !writer.is_full(); i++) {
+            if (i > 0) writer.put(',');
+            Format<T>::write(writer, value[i]);
+        }
+        writer.put(']');
+    }
+};
+
+template <typename T, size_t N, size_t MAX>
+struct Format<SmallVector<T, N, MAX>> {
+    static void write(Writer &writer, const SmallVector<T, N, MAX> &value) {
+        writer.put('[');
+        for (size_t i = 0; i < value.size() && !writer.is_full(); i++) {
+            if (i > 0) writer.put(',');
+            Format<T>::write(writer, value[i]);
+        }
+        writer.put(']');
+    }
+};
+
+};
+
+};
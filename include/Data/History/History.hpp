@@ -0,0 +1,190 @@
+#pragma once
+
+// Internal includes
+#include "Data/Helper/Ring.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+
+// Standard library includes
+#include <cstdint>
+#include <type_traits>
+
+namespace Data {
+
+/**
+ * @brief A value and the time it was set
+ *
+ * @tparam T Type of the value
+ */
+template <typename T>
+struct HistorySample {
+    uint32_t time_ms;
+    T value;
+};
+
+/**
+ * @brief Summary of the samples within a period
+ *
+ * @tparam T Type of the value
+ */
+template <typename T>
+struct HistoryBucket {
+    uint32_t time_ms; // Start of the period
+    T min;
+    T max;
+    T avg;
+    uint32_t count;
+};
+
+/**
+ * @brief Fixed capacity history of a value, with the raw samples downsampled into
+ * one second and one minute tiers
+ * @note Nothing is allocated after construction, the oldest entry of each tier is
+ * overwritten when it is full
+ *
+ * @tparam T Arithmetic type of the value
+ * @tparam RAW_N Number of raw samples to keep
+ * @tparam SEC_N Number of one second buckets to keep
+ * @tparam MIN_N Number of one minute buckets to keep
+ */
+template <typename T, size_t RAW_N, size_t SEC_N, size_t MIN_N>
+class History {
+    static_assert(std::is_arithmetic<T>::value, "History can only downsample arithmetic types");
+public:
+    using sample_t = HistorySample<T>;
+    using bucket_t = HistoryBucket<T>;
+    static constexpr size_t raw_capacity = RAW_N;
+
+    History(void) :
+        raw(), seconds(), minutes(), second(1000), minute(60000), last_slot(0) { }
+
+    /**
+     * @brief Record a sample and close any bucket whose period has ended
+     *
+     * @param time_ms Time of the sample
+     * @param value The sample
+     */
+    void add(uint32_t time_ms, const T &value) {
+        close(time_ms);
+        last_slot = raw.push({time_ms, value});
+        second.add(time_ms, value, value, value, 1);
+    }
+
+    /**
+     * @brief Close any bucket whose period ended before time_ms, call periodically
+     * if samples are infrequent so the tiers stay current
+     *
+     * @param time_ms The current time
+     */
+    void close(uint32_t time_ms) {
+        bucket_t bucket;
+        if (second.close(time_ms, bucket)) {
+            seconds.push(bucket);
+            minute.add(bucket.time_ms, bucket.min, bucket.max, bucket.avg, bucket.count);
+        }
+        if (minute.close(time_ms, bucket)) {
+            minutes.push(bucket);
+        }
+    }
+
+    /**
+     * @brief Remove every sample and bucket
+     *
+     */
+    void clear(void) {
+        raw.clear();
+        seconds.clear();
+        minutes.clear();
+        second.reset();
+        minute.reset();
+    }
+
+    /**
+     * @brief Raw samples, oldest first
+     */
+    const Helper::Ring<sample_t, RAW_N> &get_raw(void) const {
+        return raw;
+    }
+
+    /**
+     * @brief Closed one second buckets, oldest first
+     */
+    const Helper::Ring<bucket_t, SEC_N> &get_seconds(void) const {
+        return seconds;
+    }
+
+    /**
+     * @brief Closed one minute buckets, oldest first
+     */
+    const Helper::Ring<bucket_t, MIN_N> &get_minutes(void) const {
+        return minutes;
+    }
+
+    /**
+     * @brief Raw samples for persisting or restoring the ring as is
+     */
+    Helper::Ring<sample_t, RAW_N> &get_raw(void) {
+        return raw;
+    }
+
+    /**
+     * @brief The raw slot written by the latest add
+     */
+    size_t get_last_slot(void) const {
+        return last_slot;
+    }
+private:
+    /**
+     * @brief Bucket that is still accumulating samples
+     */
+    class Accumulator {
+    public:
+        Accumulator(uint32_t period_ms) :
+            period_ms(period_ms), start_ms(0), min(), max(), sum(0), count(0) { }
+
+        void add(uint32_t time_ms, T min, T max, T avg, uint32_t count) {
+            if (this->count == 0) {
+                start_ms = time_ms - time_ms % period_ms;
+                this->min = min;
+                this->max = max;
+            } else {
+                if (min < this->min) this->min = min;
+                if (max > this->max) this->max = max;
+            }
+            sum += (double)avg * count;
+            this->count += count;
+        }
+
+        bool close(uint32_t time_ms, bucket_t &bucket) {
+            if (count == 0 || (uint32_t)(time_ms - start_ms) < period_ms) {
+                return false;
+            }
+            bucket = {start_ms, min, max, (T)(sum / count), count};
+            reset();
+            return true;
+        }
+
+        void reset(void) {
+            sum = 0;
+            count = 0;
+        }
+    private:
+        const uint32_t period_ms;
+        uint32_t start_ms;
+        T min;
+        T max;
+        double sum;
+        uint32_t count;
+    };
+
+    Helper::Ring<sample_t, RAW_N> raw;
+    Helper::Ring<bucket_t, SEC_N> seconds;
+    Helper::Ring<bucket_t, MIN_N> minutes;
+    Accumulator second;
+    Accumulator minute;
+    size_t last_slot;
+};
+
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+// Internal includes
+#include "SetData.hpp"
+#include "History/History.hpp"
+#include "Helper/Clock.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+
+// Standard library includes
+
+namespace Data {
+
+/**
+ * @brief SetData that also keeps a timestamped history of its changes
+ *
+ * @tparam T Arithmetic type of value to hold
+ * @tparam RAW_N Number of raw samples to keep
+ * @tparam SEC_N Number of one second buckets to keep
+ * @tparam MIN_N Number of one minute buckets to keep
+ */
+template <typename T, size_t RAW_N, size_t SEC_N = 60, size_t MIN_N = 60>
+class HistoryData : public SetData<T> {
+public:
+    using history_t = History<T, RAW_N, SEC_N, MIN_N>;
+
+    /**
+     * @brief Constructor
+     *
+     * @param sub_d SubscribeDelegate to use for subscribing
+     * @param store_d StorageDelegate to use for storing
+     * @param set_d SetDelegate to use for setting
+     * @param history History every value set is added to
+     */
+    HistoryData(SubscribeDelegate<T> *sub_d, StorageDelegate<T> *store_d, SetDelegate<T> *set_d, history_t *history, const char *name) :
+        SetData<T>(sub_d, store_d, set_d, name), history(history) { }
+
+    /**
+     * @brief Deleted Copy Constructor
+     *
+     */
+    HistoryData(const HistoryData &) = delete;
+
+    /**
+     * @brief Default Move Constructor
+     *
+     */
+    HistoryData(HistoryData &&) = default;
+
+    /**
+     * @brief Get the history of the value
+     */
+    const history_t &get_history(void) const {
+        return *history;
+    }
+
+    /**
+     * @brief Close any downsampling bucket whose period has ended, call periodically
+     * if the value changes infrequently so the tiers stay current
+     */
+    void tick(void) {
+        history->close(Helper::now_ms());
+    }
+protected:
+    /**
+     * @brief Add every new value to the history as it is set, before it is stored so the
+     * segment it lands in is the one written, and even while subscribers are muted
+     */
+    virtual void accept(const T &next) override {
+        history->add(Helper::now_ms(), next);
+    }
+private:
+    history_t *history;
+};
+
+};
@@ -0,0 +1,96 @@
+#pragma once
+
+// Internal includes
+#include "Data/Helper/Arena.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+#include "FreeRTOS/FreeRTOS.h"
+#include "FreeRTOS/semphr.h"
+
+// Standard library includes
+#include <atomic>
+
+namespace Data {
+
+namespace Helper {
+
+/**
+ * @brief Collects objects that were written from interrupts and applies their values
+ * later on a task
+ *
+ */
+class IsrDispatcher {
+public:
+    /**
+     * @brief Abstract object that can be queued on the dispatcher from an interrupt
+     *
+     */
+    class Deferred {
+    public:
+        Deferred(void) :
+            next(nullptr), queued(false) { }
+
+        virtual ~Deferred() = default;
+
+        /**
+         * @brief Apply the value written from the interrupt, called on the dispatcher's task
+         *
+         */
+        virtual void apply(void) = 0;
+    private:
+        friend class IsrDispatcher;
+        Deferred *next;
+        std::atomic<bool> queued;
+    };
+
+    /**
+     * @brief Constructor
+     *
+     */
+    IsrDispatcher(void);
+
+    /**
+     * @brief Destructor
+     *
+     */
+    ~IsrDispatcher();
+
+    IsrDispatcher(const IsrDispatcher &) = delete;
+
+    /**
+     * @brief Queue an object to be applied, safe to call from an interrupt
+     * @note An object that is already queued is not queued again
+     *
+     * @param deferred The object to queue
+     * @param higher_prio_woken Set to pdTRUE if a context switch should be requested
+     * before the interrupt exits, may be nullptr
+     */
+    void defer_from_isr(Deferred *deferred, BaseType_t *higher_prio_woken);
+
+    /**
+     * @brief Wait until an object has been queued
+     *
+     * @param timeout Ticks to wait
+     * @retval True if something was queued
+     */
+    bool wait(TickType_t timeout = portMAX_DELAY);
+
+    /**
+     * @brief Apply every queued object, call from the task that owns the objects
+     *
+     * @return size_t Number of objects applied
+     */
+    size_t process(void);
+private:
+    std::atomic<Deferred *> pending;
+    SemaphoreHandle_t sem_h;
+#if CONFIG_DATA_NO_HEAP
+    StaticSemaphore_t sem_buf;
+#endif
+};
+
+};
+
+};
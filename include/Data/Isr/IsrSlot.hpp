@@ -0,0 +1,84 @@
+#pragma once
+
+// Internal includes
+
+// bwl component includes
+
+// Esp-idf component includes
+
+// Standard library includes
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+namespace Data {
+
+namespace Helper {
+
+/**
+ * @brief Wait-free latest value slot between one interrupt (writer) and one task (reader)
+ * @note A triple buffer, the writer and reader each own a buffer and swap it with the
+ * shared middle one, so neither side ever waits or sees a torn value
+ *
+ * @tparam T Trivially copyable type of the value
+ */
+template <typename T>
+class IsrSlot {
+    static_assert(std::is_trivially_copyable<T>::value, "IsrSlot values are copied from interrupts");
+public:
+    IsrSlot(void) :
+        buffers(), back(0), front(1), middle(2), overruns(0) { }
+
+    /**
+     * @brief Publish a value, safe to call from an interrupt
+     *
+     * @param value The value to publish
+     * @retval True if the previously published value was never read and has been replaced
+     */
+    bool write(const T &value) {
+        buffers[back] = value;
+        uint32_t prev = middle.exchange(back | DIRTY, std::memory_order_acq_rel);
+        back = prev & INDEX;
+        if (prev & DIRTY) {
+            overruns.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Take the latest published value, called from a task
+     *
+     * @param value Reference to copy the value into
+     * @retval True if a value was published since the last read
+     */
+    bool read(T &value) {
+        if ((middle.load(std::memory_order_acquire) & DIRTY) == 0) {
+            return false;
+        }
+        uint32_t prev = middle.exchange(front, std::memory_order_acq_rel);
+        front = prev & INDEX;
+        value = buffers[front];
+        return true;
+    }
+
+    /**
+     * @brief Number of values that were replaced before they were read
+     */
+    uint32_t get_overruns(void) const {
+        return overruns.load(std::memory_order_relaxed);
+    }
+private:
+    static constexpr uint32_t INDEX = 0x3;
+    static constexpr uint32_t DIRTY = 0x4;
+
+    T buffers[3];
+    uint32_t back;  // Owned by the writer
+    uint32_t front; // Owned by the reader
+    std::atomic<uint32_t> middle;
+    std::atomic<uint32_t> overruns;
+};
+
+};
+
+};
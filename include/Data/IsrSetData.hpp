@@ -0,0 +1,85 @@
+#pragma once
+
+// Internal includes
+#include "SetData.hpp"
+#include "Isr/IsrSlot.hpp"
+#include "Isr/IsrDispatcher.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+
+// Standard library includes
+
+namespace Data {
+
+/**
+ * @brief SetData that can also be set from an interrupt
+ * @note set_from_isr only publishes the value, the dispatcher's task later runs the
+ * normal set (verify, notify, copy and store). Values written faster than the task
+ * applies them are coalesced and counted as overruns.
+ *
+ * @tparam T Trivially copyable type of value to hold
+ */
+template <typename T>
+class IsrSetData : public SetData<T>, public Helper::IsrDispatcher::Deferred {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param sub_d SubscribeDelegate to use for subscribing
+     * @param store_d StorageDelegate to use for storing
+     * @param set_d SetDelegate to use for setting
+     * @param dispatcher Dispatcher whose task applies values set from interrupts
+     */
+    IsrSetData(SubscribeDelegate<T> *sub_d, StorageDelegate<T> *store_d, SetDelegate<T> *set_d,
+            Helper::IsrDispatcher *dispatcher, const char *name) :
+        SetData<T>(sub_d, store_d, set_d, name), dispatcher(dispatcher), slot() { }
+
+    /**
+     * @brief Deleted Copy Constructor
+     *
+     */
+    IsrSetData(const IsrSetData &) = delete;
+
+    /**
+     * @brief Deleted Move Constructor, the dispatcher may hold a pointer to this object
+     *
+     */
+    IsrSetData(IsrSetData &&) = delete;
+
+    /**
+     * @brief Publish a new value to be set on the dispatcher's task, safe to call from an interrupt
+     *
+     * @param next The potential new value
+     * @param higher_prio_woken Set to pdTRUE if a context switch should be requested
+     * before the interrupt exits, may be nullptr
+     */
+    void set_from_isr(const T &next, BaseType_t *higher_prio_woken = nullptr) {
+        slot.write(next);
+        dispatcher->defer_from_isr(this, higher_prio_woken);
+    }
+
+    /**
+     * @brief Number of values set from an interrupt that were replaced before being applied
+     */
+    uint32_t get_overruns(void) const {
+        return slot.get_overruns();
+    }
+
+    /**
+     * @brief Set the latest value published by set_from_isr, called by the dispatcher
+     *
+     */
+    virtual void apply(void) override final {
+        T next;
+        if (slot.read(next)) {
+            SetData<T>::set(next);
+        }
+    }
+private:
+    Helper::IsrDispatcher *dispatcher;
+    Helper::IsrSlot<T> slot;
+};
+
+};
@@ -0,0 +1,274 @@
+#pragma once
+
+// Internal includes
+#include "Data/Helper/Function.hpp"
+#include "Data/Helper/Codec.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+
+// Standard library includes
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+
+namespace Data {
+
+/**
+ * @brief One entry of a MapTable, kept in a fixed slot for as long as its key is in the table
+ *
+ * @tparam K Type of the key
+ * @tparam V Type of the value
+ */
+template <typename K, typename V>
+struct MapSlot {
+    K key;
+    V value;
+    bool used;
+};
+
+/**
+ * @brief What changed in a MapData, passed to its entry subscribers
+ *
+ * @tparam K Type of the key
+ * @tparam V Type of the value
+ */
+template <typename K, typename V>
+struct MapChange {
+    const K *key;   // Key that changed, nullptr when the whole map may have changed (reset, load)
+    const V *value; // New value of the key, nullptr if it was erased
+};
+
+/**
+ * @brief Fixed capacity map whose entries stay in the slot they were inserted in, with
+ * a sorted index of the slots for O(log n) lookups
+ * @note Slots are what gets persisted, so inserting or erasing a key only changes its
+ * own slot. Nothing is allocated and the table is trivially copyable when K and V are.
+ *
+ * @tparam K Trivially copyable type of the keys
+ * @tparam V Trivially copyable type of the values
+ * @tparam N Number of slots
+ * @tparam Cmp Strict ordering of keys
+ */
+template <typename K, typename V, size_t N, typename Cmp = std::less<K>>
+class MapTable {
+    static_assert(std::is_trivially_copyable<K>::value && std::is_trivially_copyable<V>::value,
+        "MapTable keys and values must be trivially copyable to be persisted");
+    static_assert(N > 0 && N <= UINT16_MAX, "MapTable must have between 1 and 65535 slots");
+public:
+    using slot_t = MapSlot<K, V>;
+    static constexpr size_t capacity = N;
+
+    MapTable(void) :
+        slots(), index(), count(0), last_slot(0) { }
+
+    /**
+     * @brief Find the value of a key
+     *
+     * @return const V* The key's value, nullptr if the key isn't in the table
+     */
+    const V *find(const K &key) const {
+        size_t slot = find_slot(key);
+        return slot < N ? &slots[slot].value : nullptr;
+    }
+
+    /**
+     * @brief Find the slot holding a key
+     *
+     * @return size_t The key's slot, N if the key isn't in the table
+     */
+    size_t find_slot(const K &key) const {
+        size_t i = lower_bound(key);
+        if (i < count && !Cmp()(key, slots[index[i]].key)) {
+            return index[i];
+        }
+        return N;
+    }
+
+    /**
+     * @brief Insert a key into the first free slot or replace its value
+     *
+     * @return size_t The key's slot, N if the key was new and the table is full
+     */
+    size_t insert_or_assign(const K &key, const V &value) {
+        size_t i = lower_bound(key);
+        if (i < count && !Cmp()(key, slots[index[i]].key)) {
+            slots[index[i]].value = value;
+            last_slot = index[i];
+            return index[i];
+        }
+        if (count == N) {
+            return N;
+        }
+
+        size_t slot = 0;
+        while (slots[slot].used) {
+            slot++;
+        }
+        slots[slot].key = key;
+        slots[slot].value = value;
+        slots[slot].used = true;
+        for (size_t j = count; j > i; j--) {
+            index[j] = index[j - 1];
+        }
+        index[i] = (uint16_t)slot;
+        count++;
+        last_slot = slot;
+        return slot;
+    }
+
+    /**
+     * @brief Remove a key, its slot is zeroed so stored slots only depend on their contents
+     *
+     * @return size_t The slot the key was in, N if the key isn't in the table
+     */
+    size_t erase(const K &key) {
+        size_t i = lower_bound(key);
+        if (i == count || Cmp()(key, slots[index[i]].key)) {
+            return N;
+        }
+        size_t slot = index[i];
+        slots[slot] = slot_t();
+        for (size_t j = i + 1; j < count; j++) {
+            index[j - 1] = index[j];
+        }
+        count--;
+        last_slot = slot;
+        return slot;
+    }
+
+    /**
+     * @brief Empty every slot
+     * @note Every slot counts as changed afterwards, see get_last_slot
+     *
+     */
+    void clear(void) {
+        for (slot_t &slot : slots) {
+            slot = slot_t();
+        }
+        count = 0;
+        last_slot = N;
+    }
+
+    /**
+     * @brief Rebuild the index after the slots were written directly, e.g. loaded,
+     * slots repeating a key already indexed are emptied
+     * @note Every slot counts as changed afterwards, see get_last_slot
+     *
+     */
+    void rebuild(void) {
+        count = 0;
+        last_slot = N;
+        for (size_t slot = 0; slot < N; slot++) {
+            if (!slots[slot].used) {
+                slots[slot] = slot_t();
+                continue;
+            }
+            size_t i = lower_bound(slots[slot].key);
+            if (i < count && !Cmp()(slots[slot].key, slots[index[i]].key)) {
+                slots[slot] = slot_t();
+                continue;
+            }
+            for (size_t j = count; j > i; j--) {
+                index[j] = index[j - 1];
+            }
+            index[i] = (uint16_t)slot;
+            count++;
+        }
+    }
+
+    /**
+     * @brief Call fn with every entry in key order
+     */
+    void for_each(const Helper::Callback<void(const K &key, const V &value)> &fn) const {
+        for (size_t i = 0; i < count; i++) {
+            fn(slots[index[i]].key, slots[index[i]].value);
+        }
+    }
+
+    /**
+     * @brief Get the i-th entry in key order, i must be below size
+     */
+    const slot_t &at(size_t i) const {
+        return slots[index[i]];
+    }
+
+    /**
+     * @brief Slot changed by the last insert_or_assign or erase, N after a clear or rebuild
+     */
+    size_t get_last_slot(void) const {
+        return last_slot;
+    }
+
+    slot_t *get_slots(void) {
+        return slots;
+    }
+
+    const slot_t *get_slots(void) const {
+        return slots;
+    }
+
+    size_t size(void) const {
+        return count;
+    }
+
+    bool empty(void) const {
+        return count == 0;
+    }
+private:
+    size_t lower_bound(const K &key) const {
+        size_t low = 0;
+        size_t high = count;
+        while (low < high) {
+            size_t mid = (low + high) / 2;
+            if (Cmp()(slots[index[mid]].key, key)) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        return low;
+    }
+
+    slot_t slots[N];
+    uint16_t index[N]; // Slots in key order
+    size_t count;
+    size_t last_slot;
+};
+
+namespace Helper {
+
+template <typename K, typename V, size_t N, typename Cmp>
+struct has_codec<MapTable<K, V, N, Cmp>> : std::true_type { };
+
+/**
+ * @brief Codec for MapTables, encoded as their slots
+ * @note The index is rebuilt from the decoded slots rather than trusted
+ */
+template <typename K, typename V, size_t N, typename Cmp>
+struct Codec<MapTable<K, V, N, Cmp>> {
+    using table_t = MapTable<K, V, N, Cmp>;
+    static constexpr bool supported = true;
+
+    static size_t size(const table_t &value) {
+        return N * sizeof(typename table_t::slot_t);
+    }
+
+    static void encode(const table_t &value, uint8_t *buf) {
+        std::memcpy(buf, value.get_slots(), size(value));
+    }
+
+    static bool decode(table_t &value, const uint8_t *buf, size_t buf_sz) {
+        if (buf_sz != size(value)) return false;
+        std::memcpy(value.get_slots(), buf, buf_sz);
+        value.rebuild();
+        return true;
+    }
+};
+
+};
+
+};
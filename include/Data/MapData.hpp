@@ -0,0 +1,228 @@
+#pragma once
+
+// Internal includes
+#include "BaseData.hpp"
+#include "Map/MapTable.hpp"
+#include "Helper/Compare.hpp"
+#include "Helper/Function.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+
+// Standard library includes
+#include <functional>
+#include <memory>
+
+namespace Data {
+
+/**
+ * @brief BaseData holding a keyed map of up to N entries, where setting or erasing a key
+ * only notifies that key's subscribers and only dirties the storage of its slot
+ * @note Subscribers of the whole table (sub, sub_change) are notified after every change.
+ * Entry subscribers are notified after the change too, and with every key when the
+ * whole table changes (reset, set_default, load_or_reset, unmute_sub, decode).
+ *
+ * @tparam K Trivially copyable type of the keys
+ * @tparam V Trivially copyable type of the values
+ * @tparam N Maximum number of entries
+ * @tparam Cmp Strict ordering of keys
+ */
+template <typename K, typename V, size_t N, typename Cmp = std::less<K>>
+class MapData : public BaseData<MapTable<K, V, N, Cmp>> {
+public:
+    using table_t = MapTable<K, V, N, Cmp>;
+    using change_t = MapChange<K, V>;
+    using sub_id_t = typename SubscribeDelegate<change_t>::sub_id_t;
+    using change_cb_t = typename SubscribeDelegate<change_t>::sub_cb_t;
+    using entry_cb_t = Helper::Callback<void(const V *value)>;
+
+    /**
+     * @brief Constructor
+     *
+     * @param sub_d SubscribeDelegate to use for subscribing to the whole table
+     * @param entry_d SubscribeDelegate to use for subscribing to entries
+     * @param store_d StorageDelegate to use for storing, e.g. a StorageMap
+     */
+    MapData(SubscribeDelegate<table_t> *sub_d, SubscribeDelegate<change_t> *entry_d, StorageDelegate<table_t> *store_d, const char *name) :
+        BaseData<table_t>(sub_d, store_d, name), entry_d(entry_d), changing(false),
+        notified(&this->value)
+    {
+        BaseData<table_t>::sub_internal([this](const table_t &table) {
+            if (!changing) {
+                notified = &table;
+                this->entry_d->notify(change_t{nullptr, nullptr}, this);
+                notified = &this->value;
+            }
+        });
+    }
+
+    /**
+     * @brief Deleted Copy Constructor
+     *
+     */
+    MapData(const MapData &) = delete;
+
+    /**
+     * @brief Deleted Move Constructor, the table subscription refers to this object
+     *
+     */
+    MapData(MapData &&) = delete;
+
+    /**
+     * @brief Set the value of a key, adding the key if it is new
+     * @note Nothing is notified or stored if the key already holds a value with the same bytes
+     *
+     * @retval False if the key is new and the map is full
+     */
+    bool set(const K &key, const V &value) {
+        table_t &table = BaseData<table_t>::value;
+        const V *current = table.find(key);
+        if (current && Helper::first_difference(current, &value, sizeof(V)) == sizeof(V)) {
+            return true;
+        }
+        size_t slot = table.insert_or_assign(key, value);
+        if (slot == N) {
+            return false;
+        }
+        changed(&table.get_slots()[slot].key, &table.get_slots()[slot].value);
+        return true;
+    }
+
+    /**
+     * @brief Remove a key
+     *
+     * @retval False if the key isn't in the map
+     */
+    bool erase(const K &key) {
+        if (BaseData<table_t>::value.erase(key) == N) {
+            return false;
+        }
+        changed(&key, nullptr);
+        return true;
+    }
+
+    /**
+     * @brief Find the value of a key
+     * @note While entry subscribers are notified of a decode this is the decoded value,
+     * the table only holds it once they return
+     *
+     * @return const V* The key's value, nullptr if the key isn't in the map
+     */
+    const V *find(const K &key) const {
+        return notified->find(key);
+    }
+
+    bool contains(const K &key) const {
+        return find(key) != nullptr;
+    }
+
+    size_t size(void) const {
+        return notified->size();
+    }
+
+    /**
+     * @brief Subscribe to changes of one key
+     *
+     * @param key Key to watch, it doesn't have to be in the map yet
+     * @param entry_cb Callback called with the key's new value, nullptr once it is erased
+     * @return sub_id_t id to be used to unsub_entry
+     */
+    sub_id_t sub_entry(const K &key, entry_cb_t entry_cb) {
+        struct Entry {
+            K key;
+            entry_cb_t cb;
+        };
+        std::shared_ptr<Entry> entry = std::allocate_shared<Entry>(Helper::Allocator<Entry>(), Entry{key, entry_cb});
+        return entry_d->sub([this, entry](const change_t &change) {
+            if (change.key == nullptr) {
+                entry->cb(find(entry->key));
+            } else if (!Cmp()(*change.key, entry->key) && !Cmp()(entry->key, *change.key)) {
+                entry->cb(change.value);
+            }
+        });
+    }
+
+    /**
+     * @brief Subscribe to the changes of every key
+     *
+     * @param change_cb Callback called with each change
+     * @return sub_id_t id to be used to unsub_entry
+     */
+    sub_id_t sub_changes(change_cb_t change_cb) {
+        return entry_d->sub(change_cb);
+    }
+
+    /**
+     * @brief Unsubscribe a callback added with sub_entry or sub_changes
+     *
+     * @param sub_id id returned by sub_entry or sub_changes
+     */
+    void unsub_entry(sub_id_t sub_id) {
+        entry_d->unsub(sub_id);
+    }
+
+    /**
+     * @brief Write the entries as "key: value" lines under the name, or as a JSON array
+     * of [key,value] pairs
+     */
+    virtual void export_to(Helper::Writer &writer, uint32_t depth = 0) const override final {
+        const char *name = BaseDataGeneric::name;
+        if (writer.get_mode() == Helper::Writer::Mode::JSON) {
+            if (depth == 0) writer.put('{');
+            writer.put_string(name ? name : "");
+            writer.put(':');
+            format_value(writer);
+            if (depth == 0) writer.put('}');
+        } else {
+            writer.put_indent(depth);
+            if (name) {
+                writer.put(name);
+                writer.put(":");
+            }
+            writer.put('\n');
+            BaseData<table_t>::value.for_each([&writer, depth](const K &key, const V &value) {
+                writer.put_indent(depth + 1);
+                Helper::Format<K>::write(writer, key);
+                writer.put(": ");
+                Helper::Format<V>::write(writer, value);
+                writer.put('\n');
+            });
+        }
+    }
+
+    virtual void format_value(Helper::Writer &writer) const override final {
+        bool first = true;
+        writer.put('[');
+        BaseData<table_t>::value.for_each([&writer, &first](const K &key, const V &value) {
+            if (!first) writer.put(',');
+            first = false;
+            writer.put('[');
+            Helper::Format<K>::write(writer, key);
+            writer.put(',');
+            Helper::Format<V>::write(writer, value);
+            writer.put(']');
+        });
+        writer.put(']');
+    }
+private:
+    /**
+     * @brief Notify the entry and table subscribers of a change, then store the changed slot
+     *
+     */
+    void changed(const K *key, const V *value) {
+        changing = true;
+        if (!BaseData<table_t>::is_muted()) {
+            entry_d->notify(change_t{key, value}, this);
+        }
+        BaseData<table_t>::notify(BaseData<table_t>::value);
+        changing = false;
+        BaseData<table_t>::store();
+    }
+
+    SubscribeDelegate<change_t> *entry_d;
+    bool changing; // Entry subscribers were already notified of the table notify
+    const table_t *notified; // Table entry subscribers see, the decoded one during a decode
+};
+
+};
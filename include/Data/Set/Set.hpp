@@ -7,6 +7,7 @@
 // Esp-idf component includes
 
 // Standard library includes
+#include <utility>
 
 namespace Data {
 
@@ -33,12 +34,23 @@ public:
     virtual void set(const T &next) = 0;
 
     /**
-     * @brief Optionally set the object's internal value to a new value
+     * @brief Optionally set the object's internal value to a new value, moving it into
+     * place if it is accepted
      *
-     * @param next Reference to the potential new value
+     * @param next The potential new value
+     */
+    virtual void set(T &&next) {
+        set(static_cast<const T &>(next));
+    }
+
+    /**
+     * @brief Optionally set the object's internal value to a value constructed from args
+     *
+     * @param args Arguments to construct the potential new value with
      */
-    void set(const T &&next) {
-        set(next);
+    template <typename... Args>
+    void emplace(Args &&...args) {
+        set(T(std::forward<Args>(args)...));
     }
 };
 
@@ -75,6 +87,16 @@ public:
      * @param next Reference to the new value
      */
     virtual void copy(T &value, const T &next) const = 0;
+
+    /**
+     * @brief Move next into value, copies unless overridden
+     *
+     * @param value Reference to the current value
+     * @param next The new value, left in a valid but unspecified state
+     */
+    virtual void move(T &value, T &&next) const {
+        copy(value, next);
+    }
 };
 
 };
\ No newline at end of file
@@ -8,6 +8,7 @@
 // Esp-idf component includes
 
 // Standard library includes
+#include <utility>
 
 namespace Data {
 
@@ -51,6 +52,16 @@ public:
     virtual void copy(T &value, const T &next) const override final {
         value = next;
     }
+
+    /**
+     * @brief Uses the '=' operator to move over the value
+     *
+     * @param value Reference to the current value
+     * @param next The new value
+     */
+    virtual void move(T &value, T &&next) const override final {
+        value = std::move(next);
+    }
 };
 
 
@@ -8,6 +8,7 @@
 // Esp-idf component includes
 
 // Standard library includes
+#include <utility>
 
 namespace Data {
 
@@ -31,14 +32,14 @@ public:
      *
      * @return T the stored minimum
      */
-    virtual T get_min(void) const;
+    virtual T get_min(void) const = 0;
 
     /**
      * @brief Get the stored maximum
      *
      * @return T the stored maximum
      */
-    virtual T get_max(void) const;
+    virtual T get_max(void) const = 0;
 };
 
 /**
@@ -88,6 +89,16 @@ public:
         value = next;
     }
 
+    /**
+     * @brief Uses the '=' operator to move over the value
+     *
+     * @param value Reference to the current value
+     * @param next The new value
+     */
+    virtual void move(T &value, T &&next) const override final {
+        value = std::move(next);
+    }
+
     /**
      * @brief Get the stored minimum
      *
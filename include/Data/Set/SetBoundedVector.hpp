@@ -0,0 +1,100 @@
+#pragma once
+
+// Internal includes
+#include "Set.hpp"
+#include "SetBounded.hpp"
+#include "Data/Helper/Bounds.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+
+// Standard library includes
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace Data {
+
+/**
+ * @brief What a bounded vector does with elements outside of its bounds
+ *
+ */
+enum class BoundsMode : uint8_t {
+    REJECT, // Drop the whole change
+    CLAMP,  // Move the elements to the nearest bound
+};
+
+/**
+ * @brief SetDelegate that only sets a vector if every element is within the range
+ * [min, max) and it is different from the current vector
+ * @note Elements are checked with Helper::find_out_of_bounds, vectorized for float and int32_t
+ * on hosts with SSE2/AVX2
+ *
+ * @tparam T Type of the elements
+ * @tparam V Vector type, std::vector or a Helper::SmallVector of T
+ */
+template <typename T, typename V = std::vector<T>>
+class SetBoundedVector : public SetDelegate<V>, public BoundedObject<T> {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param min Minimum valid element inclusive
+     * @param max Maximum valid element exclusive
+     */
+    SetBoundedVector(const T min, const T max) :
+        min(min), max(max) { }
+
+    /**
+     * @brief Returns whether or not every element is in [min, max) and value != next
+     *
+     * @param value Reference to the current value
+     * @param next Reference to the new value
+     */
+    virtual bool verify(const V &value, const V &next) const override final {
+        return find_violation(next) == next.size() && !(value == next);
+    }
+
+    /**
+     * @brief Uses the '=' operator to copy over the value
+     *
+     * @param value Reference to the current value
+     * @param next Reference to the new value
+     */
+    virtual void copy(V &value, const V &next) const override final {
+        value = next;
+    }
+
+    /**
+     * @brief Uses the '=' operator to move over the value
+     *
+     * @param value Reference to the current value
+     * @param next The new value
+     */
+    virtual void move(V &value, V &&next) const override final {
+        value = std::move(next);
+    }
+
+    /**
+     * @brief Find the first element of next outside of [min, max)
+     *
+     * @return size_t Index of the element, next.size() if there is none
+     */
+    size_t find_violation(const V &next) const {
+        return Helper::find_out_of_bounds(next.data(), next.size(), min, max);
+    }
+
+    virtual T get_min() const override final {
+        return min;
+    }
+
+    virtual T get_max() const override final {
+        return max;
+    }
+private:
+    const T min;
+    const T max;
+};
+
+};
@@ -0,0 +1,130 @@
+#pragma once
+
+// Internal includes
+#include "Set.hpp"
+#include "Data/Helper/Compare.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+
+// Standard library includes
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace Data {
+
+namespace Helper {
+
+/**
+ * @brief Whether or not T is a contiguous container, e.g. std::vector or SmallVector, of
+ * trivially copyable elements
+ */
+template <typename T, typename = void>
+struct is_trivial_vector : std::false_type { };
+
+template <typename T>
+struct is_trivial_vector<T, std::void_t<typename T::value_type, decltype(std::declval<const T &>().data()), decltype(std::declval<const T &>().size())>> :
+    std::is_trivially_copyable<typename T::value_type> { };
+
+};
+
+/**
+ * @brief SetDelegate that only sets the value if its bytes differ from the current value,
+ * for large trivially copyable values and vectors of them
+ * @note verify finds the first differing byte with Helper::first_difference and copy only
+ * writes from there on, so a change walks the unchanged prefix once instead of twice.
+ * Values compare bitwise, so padding bytes count and -0.0 differs from 0.0. The offset is
+ * kept between verify and copy, so each object needs its own instance.
+ *
+ * @tparam T Type being set, trivially copyable or a vector of trivially copyable elements
+ */
+template <typename T>
+class SetDifferentBytes : public SetDelegate<T> {
+    static_assert(std::is_trivially_copyable<T>::value || Helper::is_trivial_vector<T>::value,
+        "SetDifferentBytes needs a trivially copyable type or a vector of one");
+public:
+    /**
+     * @brief Constructor
+     *
+     */
+    SetDifferentBytes(void) :
+        last(nullptr), offset(0) { }
+
+    /**
+     * @brief Destructor
+     *
+     */
+    ~SetDifferentBytes() = default;
+
+    /**
+     * @brief Returns whether or not the bytes of value and next differ
+     *
+     * @param value Reference to the current value
+     * @param next Reference to the new value
+     * @return true The new value is valid
+     * @return false The new value is not valid
+     */
+    virtual bool verify(const T &value, const T &next) const override final {
+        last = &next;
+        if constexpr (Helper::is_trivial_vector<T>::value) {
+            if (value.size() != next.size()) {
+                offset = 0;
+                return true;
+            }
+            size_t size = next.size() * sizeof(typename T::value_type);
+            offset = Helper::first_difference(value.data(), next.data(), size);
+            return offset < size;
+        } else {
+            offset = Helper::first_difference(&value, &next, sizeof(T));
+            return offset < sizeof(T);
+        }
+    }
+
+    /**
+     * @brief Copy over the bytes from the first one verify found to differ
+     *
+     * @param value Reference to the current value
+     * @param next Reference to the new value
+     */
+    virtual void copy(T &value, const T &next) const override final {
+        // Anything but the value verify just looked at is copied whole
+        size_t from = last == &next ? offset : 0;
+        last = nullptr;
+        if constexpr (Helper::is_trivial_vector<T>::value) {
+            if (value.size() != next.size() || from == 0) {
+                value = next;
+                return;
+            }
+            std::memcpy(reinterpret_cast<uint8_t *>(value.data()) + from,
+                reinterpret_cast<const uint8_t *>(next.data()) + from,
+                next.size() * sizeof(typename T::value_type) - from);
+        } else {
+            std::memcpy(reinterpret_cast<uint8_t *>(&value) + from,
+                reinterpret_cast<const uint8_t *>(&next) + from, sizeof(T) - from);
+        }
+    }
+
+    /**
+     * @brief Take over next's buffer if T is a vector, otherwise copy like copy
+     *
+     * @param value Reference to the current value
+     * @param next The new value
+     */
+    virtual void move(T &value, T &&next) const override final {
+        if constexpr (Helper::is_trivial_vector<T>::value) {
+            last = nullptr;
+            value = std::move(next);
+        } else {
+            copy(value, next);
+        }
+    }
+private:
+    mutable const T *last; // Value verify was last called with
+    mutable size_t offset; // First byte of last that differs
+};
+
+};
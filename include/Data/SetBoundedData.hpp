@@ -3,6 +3,7 @@
 // Internal includes
 #include "SetData.hpp"
 #include "Set/SetBounded.hpp"
+#include "Helper/Arena.hpp"
 
 // bwl component includes
 
@@ -29,7 +30,17 @@ public:
      * @param max (one past)maximum valid value
      */
     SetBoundedData(SubscribeDelegate<T> *sub_d, StorageDelegate<T> *store_d, const T min, const T max, const char *name) :
-        SetData<T>(sub_d, store_d, new SetBounded<T>(min, max), name) { }
+        SetData<T>(sub_d, store_d, Helper::create<SetBounded<T>>(min, max), name) { }
+
+    /**
+     * @brief Constructor
+     *
+     * @param sub_d SubscribeDelegate to use for subscribing
+     * @param store_d StorageDelegate to use for storing
+     * @param set_d SetBounded holding the bounds
+     */
+    SetBoundedData(SubscribeDelegate<T> *sub_d, StorageDelegate<T> *store_d, SetBounded<T> *set_d, const char *name) :
+        SetData<T>(sub_d, store_d, set_d, name) { }
 
     /**
      * @brief Deleted Copy Constructor
@@ -9,6 +9,7 @@
 // Esp-idf component includes
 
 // Standard library includes
+#include <utility>
 
 namespace Data {
 
@@ -49,11 +50,43 @@ public:
      */
     virtual void set(const T &next) override final {
         if (set_d->verify(BaseData<T>::value, next)) {
+            this->accept(next);
             BaseData<T>::notify(next);
             set_d->copy(BaseData<T>::value, next);
             BaseData<T>::store();
         }
     }
+
+    /**
+     * @brief Optionally set this object's internal value to a new value, moving it into
+     * place if it is accepted
+     *
+     * @param next The potential new value
+     */
+    virtual void set(T &&next) override final {
+        if (set_d->verify(BaseData<T>::value, next)) {
+            this->accept(next);
+            BaseData<T>::notify(next);
+            set_d->move(BaseData<T>::value, std::move(next));
+            BaseData<T>::store();
+        }
+    }
+
+    /**
+     * @brief Decode a value and set it through the SetDelegate like set does, without storing it
+     *
+     * @retval False if the value didn't decode or the SetDelegate rejected it
+     */
+    virtual bool set_encoded(const uint8_t *buf, size_t buf_sz) override final {
+        T next;
+        if (!Helper::Codec<T>::decode(next, buf, buf_sz) || !set_d->verify(BaseData<T>::value, next)) {
+            return false;
+        }
+        this->accept(next);
+        BaseData<T>::notify(next);
+        set_d->move(BaseData<T>::value, std::move(next));
+        return true;
+    }
 protected:
     const SetDelegate<T> *getSetDelegate(void) const {
         return set_d;
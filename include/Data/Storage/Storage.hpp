@@ -13,6 +13,10 @@ namespace Data {
 template<class T>
 class BaseData;
 
+namespace Helper {
+class NvsHandler;
+};
+
 /**
  * @brief Abstract interface who's implementations provide the means of storing,
  * loading, or resetting a value using an external source
@@ -57,6 +61,20 @@ public:
      * @param value Reference to the value being reset
      */
     virtual void reset(T &value) const = 0;
+
+    /**
+     * @brief Get the nvs key the value is stored under, nullptr if it isn't stored in nvs
+     */
+    virtual const char *get_nvs_key(void) const {
+        return nullptr;
+    }
+
+    /**
+     * @brief Get the handler the value is stored with, nullptr if it isn't stored in nvs
+     */
+    virtual Helper::NvsHandler *get_nvs_handler(void) const {
+        return nullptr;
+    }
 };
 
 };
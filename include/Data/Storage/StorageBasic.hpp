@@ -9,6 +9,7 @@
 // Esp-idf component includes
 
 // Standard library includes
+#include <utility>
 
 namespace Data {
 
@@ -28,9 +29,13 @@ public:
      * @param default_value The default value to use when resetting
      * @param nvs_handler Pointer to a NvsHandler to use for storing / loading
      * @param nvs_key Nvs key use to load / store the value
+     * @param priority Order the value is written in by the handler's commits
+     * @param deadline_ms Most milliseconds the value may wait for a commit, 0 for no deadline
      */
-    StorageBasic(const T default_value, Helper::NvsHandler *nvs_handler, const char *nvs_key) :
-        default_value(default_value), nvs_handler(nvs_handler), nvs_key(nvs_key), object(nullptr) { }
+    StorageBasic(T default_value, Helper::NvsHandler *nvs_handler, const char *nvs_key,
+            Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) :
+        default_value(std::move(default_value)), nvs_handler(nvs_handler), nvs_key(nvs_key), object(nullptr),
+        priority(priority), deadline_ms(deadline_ms) { }
 
     /**
      * @brief Destructor
@@ -94,11 +99,29 @@ public:
     virtual void commit(Helper::NvsHandler *handler, const char *key) const override final {
         handler->store(key, object->get());
     }
+
+    virtual Helper::NvsHandler::Priority get_priority(void) const override final {
+        return priority;
+    }
+
+    virtual uint32_t get_deadline_ms(void) const override final {
+        return deadline_ms;
+    }
+
+    virtual const char *get_nvs_key(void) const override final {
+        return nvs_key;
+    }
+
+    virtual Helper::NvsHandler *get_nvs_handler(void) const override final {
+        return nvs_handler;
+    }
 private:
     const T default_value;
     Helper::NvsHandler *nvs_handler;
     const char *nvs_key;
     const BaseData<T> *object;
+    Helper::NvsHandler::Priority priority;
+    uint32_t deadline_ms;
 };
 
 };
@@ -0,0 +1,226 @@
+#pragma once
+
+// Internal includes
+#include "Storage.hpp"
+#include "Data/Helper/NvsHandler.hpp"
+#include "Data/History/History.hpp"
+#include "Data/Helper/Clock.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+
+// Standard library includes
+#include <cstdio>
+#include <utility>
+
+namespace Data {
+
+/**
+ * @brief StorageDelegate that persists the raw samples of a History in fixed size
+ * segments, only rewriting the segments that received new samples since the last commit
+ * @note The ring position is stored under nvs_key and segment i under nvs_key followed
+ * by i as two hex digits, so nvs_key must be at most 13 characters
+ * @note Sample times are milliseconds since boot, so loaded samples are moved to end at
+ * the time of the load, keeping their spacing but not the time spent powered off
+ *
+ * @tparam T Type being stored
+ * @tparam H History type holding the samples
+ * @tparam SEG_N Number of samples per segment
+ */
+template <typename T, typename H, size_t SEG_N>
+class StorageHistory : public StorageDelegate<T>, public Helper::NvsHandler::Block {
+    using sample_t = typename H::sample_t;
+    static constexpr size_t RAW_N = H::raw_capacity;
+    static constexpr size_t SEGMENTS = RAW_N / SEG_N;
+    static_assert(RAW_N % SEG_N == 0, "Raw capacity must be a multiple of the segment size");
+    static_assert(SEGMENTS <= 256, "Too many segments to name with two hex digits");
+    static_assert(RAW_N <= UINT16_MAX, "Raw capacity must fit the stored ring position");
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param default_value The default value to use when resetting
+     * @param history The history whose raw samples are persisted
+     * @param nvs_handler Pointer to a NvsHandler to use for storing / loading
+     * @param nvs_key Nvs key prefix used to load / store the history
+     * @param priority Order the history is written in by the handler's commits
+     * @param deadline_ms Most milliseconds the history may wait for a commit, 0 for no deadline
+     */
+    StorageHistory(T default_value, H *history, Helper::NvsHandler *nvs_handler, const char *nvs_key,
+            Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) :
+        default_value(std::move(default_value)), history(history), nvs_handler(nvs_handler), nvs_key(nvs_key), dirty(), complete(false),
+        priority(priority), deadline_ms(deadline_ms) { }
+
+    /**
+     * @brief Destructor
+     *
+     */
+    virtual ~StorageHistory() {
+        nvs_handler->unsub(nvs_key);
+    }
+
+    /**
+     * @brief Reset the value to the stored default value
+     *
+     * @param value Reference to the value being reset
+     */
+    virtual void set_default(T &value) const override final {
+        value = default_value;
+    }
+
+    /**
+     * @brief Load every segment into the history, rebase the samples onto this boot's clock
+     * and set the value to the newest sample, if the history can't be loaded then clear it
+     *
+     * @param value Reference to the value being loaded / reset
+     * @retval True if the value was potentially modified
+     */
+    virtual bool load_or_reset(T &value) const override final {
+        Position position;
+        bool loaded = nvs_handler->load(nvs_key, position) && position.raw_n == RAW_N && position.seg_n == SEG_N;
+        for (size_t i = 0; loaded && i < SEGMENTS; i++) {
+            char key[16];
+            segment_key(key, i);
+            loaded = nvs_handler->load(key, &history->get_raw().get_slots()[i * SEG_N], SEG_N * sizeof(sample_t));
+        }
+
+        if (loaded && history->get_raw().restore(position.head, position.count)) {
+            complete = true;
+            if (!history->get_raw().empty()) {
+                rebase();
+                value = history->get_raw().back().value;
+            }
+        } else {
+            clear(value);
+        }
+        return true; // Always indicate that the value changed
+    }
+
+    /**
+     * @brief Mark the segment holding the newest sample to be written on the next commit
+     *
+     * @param object unused, the samples are read from the history
+     */
+    virtual void store(const BaseData<T> &object) override final {
+        dirty[history->get_last_slot() / SEG_N] = true;
+        nvs_handler->sub(nvs_key, this);
+    }
+
+    /**
+     * @brief Clear the history, its stored segments and reset the value to the default value,
+     * every segment is written on the next commit so the sample of the reset value is kept
+     *
+     * @param value Reference to the value being reset
+     */
+    virtual void reset(T &value) const override final {
+        clear(value);
+        nvs_handler->sub(nvs_key, const_cast<StorageHistory *>(this));
+    }
+
+    /**
+     * @brief Write the segments that changed since the last commit followed by the ring position
+     * @note Every segment is written the first time so that a later load finds all of them
+     *
+     * @param handler Pointer to the handler used for the store
+     * @param key Nvs key to use for the store
+     */
+    virtual void commit(Helper::NvsHandler *handler, const char *key) const override final {
+        write(handler, key);
+        for (size_t i = 0; i < SEGMENTS; i++) {
+            dirty[i] = false;
+        }
+        complete = true;
+    }
+
+    /**
+     * @brief Write what commit would to the journal, the segments stay dirty until the commit
+     *
+     * @param handler Pointer to the handler used for the store
+     * @param key Nvs key to use for the store
+     */
+    virtual void journal(Helper::NvsHandler *handler, const char *key) const override final {
+        write(handler, key);
+    }
+
+    virtual Helper::NvsHandler::Priority get_priority(void) const override final {
+        return priority;
+    }
+
+    virtual uint32_t get_deadline_ms(void) const override final {
+        return deadline_ms;
+    }
+
+    virtual const char *get_nvs_key(void) const override final {
+        return nvs_key;
+    }
+
+    virtual Helper::NvsHandler *get_nvs_handler(void) const override final {
+        return nvs_handler;
+    }
+private:
+    struct Position {
+        uint16_t head;
+        uint16_t count;
+        uint16_t raw_n;
+        uint16_t seg_n;
+    };
+
+    void clear(T &value) const {
+        nvs_handler->reset(nvs_key);
+        for (size_t i = 0; i < SEGMENTS; i++) {
+            char key[16];
+            segment_key(key, i);
+            nvs_handler->reset(key);
+            dirty[i] = false;
+        }
+        complete = false;
+        history->clear();
+        value = default_value;
+    }
+
+    void rebase(void) const {
+        // Unused slots are moved too, they are never read
+        sample_t *slots = history->get_raw().get_slots();
+        uint32_t shift = Helper::now_ms() - history->get_raw().back().time_ms;
+        for (size_t i = 0; i < RAW_N; i++) {
+            slots[i].time_ms += shift;
+        }
+        // The stored segments keep the old times, rewrite all of them with the next sample
+        complete = shift == 0;
+    }
+
+    void write(Helper::NvsHandler *handler, const char *key) const {
+        const sample_t *slots = history->get_raw().get_slots();
+        for (size_t i = 0; i < SEGMENTS; i++) {
+            if (dirty[i] || !complete) {
+                char seg_key[16];
+                segment_key(seg_key, i);
+                handler->store(seg_key, &slots[i * SEG_N], SEG_N * sizeof(sample_t));
+            }
+        }
+
+        Position position = {
+            (uint16_t)history->get_raw().get_head(),
+            (uint16_t)history->get_raw().size(),
+            (uint16_t)RAW_N,
+            (uint16_t)SEG_N,
+        };
+        handler->store(key, position);
+    }
+
+    void segment_key(char *key, size_t segment) const {
+        snprintf(key, 16, "%.13s%02x", nvs_key, (unsigned)segment);
+    }
+
+    const T default_value;
+    H *history;
+    Helper::NvsHandler *nvs_handler;
+    const char *nvs_key;
+    mutable bool dirty[SEGMENTS];
+    mutable bool complete; // Every segment exists in nvs
+    Helper::NvsHandler::Priority priority;
+    uint32_t deadline_ms;
+};
+
+};
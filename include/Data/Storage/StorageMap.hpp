@@ -0,0 +1,221 @@
+#pragma once
+
+// Internal includes
+#include "Storage.hpp"
+#include "Data/Helper/NvsHandler.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+
+// Standard library includes
+#include <cstdint>
+#include <cstdio>
+
+namespace Data {
+
+/**
+ * @brief StorageDelegate that persists the slots of a MapTable in chunks of CHUNK_N, only
+ * rewriting the chunks holding the slots changed since the last commit
+ * @note The layout is stored under nvs_key and chunk i under nvs_key followed by i as two
+ * hex digits, so nvs_key must be at most 13 characters. Without a handler or key the
+ * table is only cleared.
+ *
+ * @tparam M MapTable type
+ * @tparam CHUNK_N Number of slots per chunk
+ */
+template <typename M, size_t CHUNK_N>
+class StorageMap : public StorageDelegate<M>, public Helper::NvsHandler::Block {
+    using slot_t = typename M::slot_t;
+    static constexpr size_t N = M::capacity;
+    static constexpr size_t CHUNKS = (N + CHUNK_N - 1) / CHUNK_N;
+    static_assert(CHUNK_N > 0, "Chunks must hold at least one slot");
+    static_assert(CHUNKS <= 256, "Too many chunks to name with two hex digits");
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param nvs_handler Pointer to a NvsHandler to use for storing / loading, may be nullptr
+     * @param nvs_key Nvs key prefix used to load / store the table, may be nullptr
+     * @param priority Order the table is written in by the handler's commits
+     * @param deadline_ms Most milliseconds the table may wait for a commit, 0 for no deadline
+     */
+    StorageMap(Helper::NvsHandler *nvs_handler, const char *nvs_key,
+            Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) :
+        nvs_handler(nvs_key ? nvs_handler : nullptr), nvs_key(nvs_key), table(nullptr), dirty(), complete(false),
+        priority(priority), deadline_ms(deadline_ms) { }
+
+    /**
+     * @brief Destructor
+     *
+     */
+    virtual ~StorageMap() {
+        if (nvs_handler) {
+            nvs_handler->unsub(nvs_key);
+        }
+    }
+
+    /**
+     * @brief Empty the table, every chunk is written on the next commit
+     *
+     * @param value Reference to the table being reset
+     */
+    virtual void set_default(M &value) const override final {
+        value.clear();
+        // Every stored chunk is stale now, even if only one slot is set before the next store
+        for (size_t i = 0; i < CHUNKS; i++) {
+            dirty[i] = true;
+        }
+    }
+
+    /**
+     * @brief Load every chunk into the table, if the table can't be loaded then empty it
+     *
+     * @param value Reference to the table being loaded / reset
+     * @retval True if the table was potentially modified
+     */
+    virtual bool load_or_reset(M &value) const override final {
+        if (nvs_handler == nullptr) {
+            return false;
+        }
+        Layout layout;
+        bool loaded = nvs_handler->load(nvs_key, layout) && layout.slots == N &&
+            layout.chunk_n == CHUNK_N && layout.slot_sz == sizeof(slot_t);
+        for (size_t i = 0; loaded && i < CHUNKS; i++) {
+            char key[16];
+            chunk_key(key, i);
+            loaded = nvs_handler->load(key, &value.get_slots()[i * CHUNK_N], chunk_size(i));
+        }
+
+        if (loaded) {
+            value.rebuild();
+            complete = true;
+        } else {
+            reset(value);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Mark the chunk holding the last changed slot to be written on the next commit,
+     * every chunk if the whole table was replaced (e.g. decoded)
+     *
+     * @param object The object holding the table
+     */
+    virtual void store(const BaseData<M> &object) override final {
+        if (nvs_handler == nullptr) {
+            return;
+        }
+        table = &object.get();
+        size_t last_slot = table->get_last_slot();
+        if (last_slot == N) {
+            for (size_t i = 0; i < CHUNKS; i++) {
+                dirty[i] = true;
+            }
+        } else {
+            dirty[last_slot / CHUNK_N] = true;
+        }
+        nvs_handler->sub(nvs_key, this);
+    }
+
+    /**
+     * @brief Empty the table and erase its stored chunks
+     *
+     * @param value Reference to the table being reset
+     */
+    virtual void reset(M &value) const override final {
+        if (nvs_handler) {
+            nvs_handler->reset(nvs_key);
+            for (size_t i = 0; i < CHUNKS; i++) {
+                char key[16];
+                chunk_key(key, i);
+                nvs_handler->reset(key);
+                dirty[i] = false;
+            }
+        }
+        complete = false;
+        value.clear();
+    }
+
+    /**
+     * @brief Write the chunks that changed since the last commit followed by the layout
+     * @note Every chunk is written the first time so that a later load finds all of them
+     *
+     * @param handler Pointer to the handler used for the store
+     * @param key Nvs key to use for the store
+     */
+    virtual void commit(Helper::NvsHandler *handler, const char *key) const override final {
+        write(handler, key);
+        for (size_t i = 0; i < CHUNKS; i++) {
+            dirty[i] = false;
+        }
+        complete = true;
+    }
+
+    /**
+     * @brief Write what commit would to the journal, the chunks stay dirty until the commit
+     *
+     * @param handler Pointer to the handler used for the store
+     * @param key Nvs key to use for the store
+     */
+    virtual void journal(Helper::NvsHandler *handler, const char *key) const override final {
+        write(handler, key);
+    }
+
+    virtual Helper::NvsHandler::Priority get_priority(void) const override final {
+        return priority;
+    }
+
+    virtual uint32_t get_deadline_ms(void) const override final {
+        return deadline_ms;
+    }
+
+    virtual const char *get_nvs_key(void) const override final {
+        return nvs_handler ? nvs_key : nullptr;
+    }
+
+    virtual Helper::NvsHandler *get_nvs_handler(void) const override final {
+        return nvs_handler;
+    }
+private:
+    struct Layout {
+        uint16_t slots;
+        uint16_t chunk_n;
+        uint16_t slot_sz;
+        uint16_t reserved;
+    };
+
+    void write(Helper::NvsHandler *handler, const char *key) const {
+        const slot_t *slots = table->get_slots();
+        for (size_t i = 0; i < CHUNKS; i++) {
+            if (dirty[i] || !complete) {
+                char chunk[16];
+                chunk_key(chunk, i);
+                handler->store(chunk, &slots[i * CHUNK_N], chunk_size(i));
+            }
+        }
+        if (!complete) {
+            Layout layout = {(uint16_t)N, (uint16_t)CHUNK_N, (uint16_t)sizeof(slot_t), 0};
+            handler->store(key, layout);
+        }
+    }
+
+    static size_t chunk_size(size_t chunk) {
+        size_t end = (chunk + 1) * CHUNK_N < N ? (chunk + 1) * CHUNK_N : N;
+        return (end - chunk * CHUNK_N) * sizeof(slot_t);
+    }
+
+    void chunk_key(char *key, size_t chunk) const {
+        snprintf(key, 16, "%.13s%02x", nvs_key, (unsigned)chunk);
+    }
+
+    Helper::NvsHandler *nvs_handler;
+    const char *nvs_key;
+    const M *table;
+    mutable bool dirty[CHUNKS];
+    mutable bool complete; // Every chunk and the layout have been written
+    Helper::NvsHandler::Priority priority;
+    uint32_t deadline_ms;
+};
+
+};
@@ -0,0 +1,97 @@
+#pragma once
+
+// Internal includes
+#include "Storage.hpp"
+#include "Data/Helper/MappedBlob.hpp"
+#include "Data/Helper/Span.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+
+// Standard library includes
+#include <type_traits>
+
+namespace Data {
+
+/**
+ * @brief Read-only StorageDelegate that views a table of values in place through a
+ * Helper::MappedBlob, rather than loading a copy of it
+ * @note Storing does nothing, tables are written by whatever flashes the partition
+ *
+ * @tparam T Type of the table's elements
+ */
+template <typename T>
+class StorageMapped : public StorageDelegate<Helper::Span<const T>> {
+    static_assert(std::is_trivially_copyable<T>::value, "Mapped tables must hold trivially copyable values");
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param label Label of the data partition holding the table, nullptr to only use nvs
+     * @param offset Offset of the table's header in the partition
+     * @param nvs_handler NvsHandler to copy the table from when there is no partition, may be nullptr
+     * @param nvs_key Nvs key of the table, may be nullptr
+     */
+    StorageMapped(const char *label, size_t offset, Helper::NvsHandler *nvs_handler, const char *nvs_key) :
+        blob(label, offset, nvs_handler, nvs_key) { }
+
+    /**
+     * @brief Destructor
+     *
+     */
+    virtual ~StorageMapped() = default;
+
+    /**
+     * @brief Reset the view to an empty table, the table stays open
+     *
+     * @param value Reference to the view being reset
+     */
+    virtual void set_default(Helper::Span<const T> &value) const override final {
+        value = Helper::Span<const T>();
+    }
+
+    /**
+     * @brief Open the table and view it, or view an empty table if it is missing or invalid
+     *
+     * @param value Reference to the view being loaded / reset
+     */
+    virtual bool load_or_reset(Helper::Span<const T> &value) const override final {
+        if (blob.open(sizeof(T))) {
+            value = Helper::Span<const T>(static_cast<const T *>(blob.get_data()), blob.get_count());
+            return true;
+        }
+        value = Helper::Span<const T>();
+        return false;
+    }
+
+    /**
+     * @brief Does nothing
+     *
+     * @param object unused
+     */
+    virtual void store(const BaseData<Helper::Span<const T>> &object) override final {
+        // DOES NOTHING
+    }
+
+    /**
+     * @brief Close the table and view an empty one, the stored table is left alone
+     *
+     * @param value Reference to the view being reset
+     */
+    virtual void reset(Helper::Span<const T> &value) const override final {
+        value = Helper::Span<const T>();
+        blob.close();
+    }
+
+    /**
+     * @brief Get the blob the table is read from
+     */
+    const Helper::MappedBlob &get_blob(void) const {
+        return blob;
+    }
+private:
+    mutable Helper::MappedBlob blob;
+};
+
+};
@@ -8,6 +8,7 @@
 // Esp-idf component includes
 
 // Standard library includes
+#include <utility>
 
 namespace Data {
 
@@ -25,8 +26,8 @@ public:
      *
      * @param default_value The default value to use when resetting
      */
-    StorageNone(const T default_value) :
-        default_value(default_value) { }
+    StorageNone(T default_value) :
+        default_value(std::move(default_value)) { }
 
     /**
      * @brief Destructor
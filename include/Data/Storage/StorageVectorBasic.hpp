@@ -18,18 +18,22 @@ namespace Data {
  * able to clear the vector
  *
  * @tparam T Type stored in vector
+ * @tparam V Vector type, std::vector or a Helper::SmallVector of T
  */
-template <typename T>
-class StorageVectorBasic : public StorageDelegate<std::vector<T>>, public Helper::NvsHandler::Block {
+template <typename T, typename V = std::vector<T>>
+class StorageVectorBasic : public StorageDelegate<V>, public Helper::NvsHandler::Block {
 public:
     /**
      * @brief Constructor
      *
      * @param nvs_handler Pointer to a NvsHandler to use for storing / loading
      * @param nvs_key Nvs key use to load / store the value
+     * @param priority Order the value is written in by the handler's commits
+     * @param deadline_ms Most milliseconds the value may wait for a commit, 0 for no deadline
      */
-    StorageVectorBasic(Helper::NvsHandler *nvs_handler, const char *nvs_key) :
-        nvs_handler(nvs_handler), nvs_key(nvs_key), object(nullptr) { }
+    StorageVectorBasic(Helper::NvsHandler *nvs_handler, const char *nvs_key,
+            Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) :
+        nvs_handler(nvs_handler), nvs_key(nvs_key), object(nullptr), priority(priority), deadline_ms(deadline_ms) { }
 
     /**
      * @brief Destructor
@@ -44,20 +48,30 @@ public:
      *
      * @param value Reference to the value being reset
      */
-    virtual void set_default(std::vector<T> &value) const override final {
+    virtual void set_default(V &value) const override final {
         value.clear();
     }
 
     /**
      * @brief Try to load a vector from nvs and if the load fails
      * then clear the vector
+     * @note The blob's size is checked before the vector is resized, so an invalid
+     * blob never grows the vector
      *
      * @param value Reference to the vector being loaded / cleared
      */
-    virtual bool load_or_reset(std::vector<T> &value) const override final {
+    virtual bool load_or_reset(V &value) const override final {
         size_t size = nvs_handler->size(nvs_key);
+        if (size == 0 || size % sizeof(T) != 0 || size / sizeof(T) > value.max_size()) {
+            value.clear();
+            return false;
+        }
         value.resize(size / sizeof(T));
-        return (size > 0 && size % sizeof(T) == 0 && nvs_handler->load(nvs_key, &value[0], size));
+        if (!nvs_handler->load(nvs_key, value.data(), size)) {
+            value.clear();
+            return false;
+        }
+        return true;
     }
 
     /**
@@ -65,7 +79,7 @@ public:
      *
      * @param object The object who's vector is to be stored
      */
-    virtual void store(const BaseData<std::vector<T>> &object) override final {
+    virtual void store(const BaseData<V> &object) override final {
         this->object = &object;
         nvs_handler->sub(nvs_key, this);
     }
@@ -75,23 +89,41 @@ public:
      *
      * @param value Reference to the vector being cleared
      */
-    virtual void reset(std::vector<T> &value) const override final {
+    virtual void reset(V &value) const override final {
         nvs_handler->reset(nvs_key);
         value.clear();
     }
 
     virtual void commit(Helper::NvsHandler *handler, const char *key) const override final {
-        const std::vector<T> &value = object->get();
+        const V &value = object->get();
         if (value.size() == 0) {
             handler->reset(nvs_key);
         } else {
-            handler->store(key, &value[0], value.size() * sizeof(T));
+            handler->store(key, value.data(), value.size() * sizeof(T));
         }
     }
+
+    virtual Helper::NvsHandler::Priority get_priority(void) const override final {
+        return priority;
+    }
+
+    virtual uint32_t get_deadline_ms(void) const override final {
+        return deadline_ms;
+    }
+
+    virtual const char *get_nvs_key(void) const override final {
+        return nvs_key;
+    }
+
+    virtual Helper::NvsHandler *get_nvs_handler(void) const override final {
+        return nvs_handler;
+    }
 private:
     Helper::NvsHandler *nvs_handler;
     const char *nvs_key;
-    const BaseData<std::vector<T>> *object;
+    const BaseData<V> *object;
+    Helper::NvsHandler::Priority priority;
+    uint32_t deadline_ms;
 };
 
 };
@@ -16,9 +16,10 @@ namespace Data {
  * @brief StorageDelegate that does not store or load the value and only clears the vector
  *
  * @tparam T Type stored in vector
+ * @tparam V Vector type, std::vector or a Helper::SmallVector of T
  */
-template <typename T>
-class StorageVectorNone : public StorageDelegate<std::vector<T>> {
+template <typename T, typename V = std::vector<T>>
+class StorageVectorNone : public StorageDelegate<V> {
 public:
     /**
      * @brief Constructor
@@ -37,7 +38,7 @@ public:
      *
      * @param value Reference to the value being reset
      */
-    virtual void set_default(std::vector<T> &value) const override final {
+    virtual void set_default(V &value) const override final {
         value.clear();
     }
 
@@ -48,7 +49,7 @@ public:
      * @param value Reference to the value being loaded / reset
      * @retval True if the value was potentially modified
      */
-    virtual bool load_or_reset(std::vector<T> &value) const override final {
+    virtual bool load_or_reset(V &value) const override final {
         return false;
     }
 
@@ -57,7 +58,7 @@ public:
      *
      * @param object unused
      */
-    virtual void store(const BaseData<std::vector<T>> &object) override final {
+    virtual void store(const BaseData<V> &object) override final {
         // DOES NOTHING
     }
 
@@ -66,7 +67,7 @@ public:
      *
      * @param value Reference to the vector being cleared
      */
-    virtual void reset(std::vector<T> &value) const override final {
+    virtual void reset(V &value) const override final {
         value.clear();
     }
 };
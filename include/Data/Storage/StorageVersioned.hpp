@@ -0,0 +1,167 @@
+#pragma once
+
+// Internal includes
+#include "Storage.hpp"
+#include "Data/Helper/NvsHandler.hpp"
+#include "Data/Helper/Schema.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+#include "esp_log.h"
+
+// Standard library includes
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace Data {
+
+/**
+ * @brief StorageDelegate like StorageBasic that stores the value after a Helper::BlobHeader
+ * holding the version of its layout, so values stored by older firmware are migrated
+ * rather than reset or loaded as garbage
+ * @note A load whose header matches the current version and size costs one blob read
+ * and one header compare. Otherwise the blob is read again whole, converted by the
+ * schema's migration from its version and written back straight away in the current
+ * layout, so it migrates only once. Blobs with no migration are reset.
+ *
+ * @tparam T Trivially copyable type being stored
+ */
+template <typename T>
+class StorageVersioned : public StorageDelegate<T>, public Helper::NvsHandler::Block {
+    static_assert(std::is_trivially_copyable<T>::value, "StorageVersioned only stores trivially copyable types");
+    static_assert(sizeof(Helper::VersionedBlob<T>) == sizeof(Helper::BlobHeader) + sizeof(T), "The value must follow the header");
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param default_value The default value to use when resetting
+     * @param schema Version of T's layout and migrations from older versions
+     * @param nvs_handler Pointer to a NvsHandler to use for storing / loading
+     * @param nvs_key Nvs key use to load / store the value
+     * @param priority Order the value is written in by the handler's commits
+     * @param deadline_ms Most milliseconds the value may wait for a commit, 0 for no deadline
+     */
+    StorageVersioned(T default_value, Helper::Schema<T> schema, Helper::NvsHandler *nvs_handler, const char *nvs_key,
+            Helper::NvsHandler::Priority priority = Helper::NvsHandler::Priority::NORMAL, uint32_t deadline_ms = 0) :
+        default_value(std::move(default_value)), schema(schema), nvs_handler(nvs_handler), nvs_key(nvs_key), object(nullptr),
+        priority(priority), deadline_ms(deadline_ms) { }
+
+    /**
+     * @brief Destructor
+     *
+     */
+    virtual ~StorageVersioned() {
+        nvs_handler->unsub(nvs_key);
+    }
+
+    /**
+     * @brief Reset the value to the stored default value
+     *
+     * @param value Reference to the value being reset
+     */
+    virtual void set_default(T &value) const override final {
+        value = default_value;
+    }
+
+    /**
+     * @brief Load the value, migrating it if it was stored by an older version, and
+     * if neither works reset the value
+     *
+     * @param value Reference to the value being loaded / reset
+     * @retval True if the value was potentially modified
+     */
+    virtual bool load_or_reset(T &value) const override final {
+        Helper::VersionedBlob<T> blob;
+        if (nvs_handler->load(nvs_key, &blob, sizeof(blob)) && blob.header == get_header()) {
+            value = blob.value;
+        } else if (!migrate(value)) {
+            reset(value);
+        }
+        return true; // Always indicate that the value changed
+    }
+
+    /**
+     * @brief Store the object's value to nvs
+     *
+     * @param object The object who's value is to be stored
+     */
+    virtual void store(const BaseData<T> &object) override final {
+        this->object = &object;
+        nvs_handler->sub(nvs_key, this);
+    }
+
+    /**
+     * @brief Reset the value to the default value and clear the stored value
+     *
+     * @param value Reference to the value being reset
+     */
+    virtual void reset(T &value) const override final {
+        nvs_handler->reset(nvs_key);
+        value = default_value;
+    }
+
+    /**
+     * @brief If store was previously called then write the object's value to nvs
+     *
+     * @param handler Pointer to the handler used for the store
+     * @param key Nvs key to use for the store
+     */
+    virtual void commit(Helper::NvsHandler *handler, const char *key) const override final {
+        handler->store(key, Helper::VersionedBlob<T>{get_header(), object->get()});
+    }
+
+    virtual Helper::NvsHandler::Priority get_priority(void) const override final {
+        return priority;
+    }
+
+    virtual uint32_t get_deadline_ms(void) const override final {
+        return deadline_ms;
+    }
+
+    virtual const char *get_nvs_key(void) const override final {
+        return nvs_key;
+    }
+
+    virtual Helper::NvsHandler *get_nvs_handler(void) const override final {
+        return nvs_handler;
+    }
+private:
+    Helper::BlobHeader get_header(void) const {
+        return Helper::BlobHeader{Helper::BlobHeader::MAGIC, schema.version, sizeof(T)};
+    }
+
+    /**
+     * @brief Convert a blob of another version or size and write it back in the current layout
+     *
+     * @retval True if value now holds the migrated value
+     */
+    bool migrate(T &value) const {
+        T next = default_value;
+        bool migrated = Helper::read_blob(*nvs_handler, nvs_key, [this, &next](uint16_t version, const uint8_t *data, size_t data_sz) {
+            const Helper::Migration<T> *migration = schema.find(version);
+            if (migration == nullptr) {
+                ESP_LOGW("StorageVersioned", "%s has no migration from version %u", nvs_key, (unsigned)version);
+                return false;
+            }
+            return migration->migrate(data, data_sz, next);
+        });
+        if (!migrated) {
+            return false;
+        }
+        value = next;
+        nvs_handler->store(nvs_key, Helper::VersionedBlob<T>{get_header(), value});
+        return true;
+    }
+
+    const T default_value;
+    Helper::Schema<T> schema;
+    Helper::NvsHandler *nvs_handler;
+    const char *nvs_key;
+    const BaseData<T> *object;
+    Helper::NvsHandler::Priority priority;
+    uint32_t deadline_ms;
+};
+
+};
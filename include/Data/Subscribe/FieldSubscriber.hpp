@@ -0,0 +1,188 @@
+#pragma once
+
+// Internal includes
+#include "Subscribe.hpp"
+#include "Data/BaseData.hpp"
+#include "Data/Helper/Arena.hpp"
+#include "Data/Helper/Function.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+
+// Standard library includes
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace Data {
+
+/**
+ * @brief Subscriptions to single members of a struct held by a BaseData, only called
+ * when their member changed
+ * @note Subscriptions to the same member share a group holding the member's previous
+ * value, so each member is compared once per notify however many subscribers it has.
+ * The previous value starts as the object's current value, members are compared with
+ * their '==' operator.
+ *
+ * @tparam T Struct type held by the object
+ */
+template <typename T>
+class FieldSubscriber {
+public:
+    using sub_id_t = typename SubscribeDelegate<T>::sub_id_t;
+
+    /**
+     * @brief Callback function used when a member subscriber is notified, F is deduced
+     * from the member pointer only so lambdas can be passed
+     *
+     * @tparam F Type of the member
+     */
+    template <typename F>
+    struct field_cb_t {
+        using type = Helper::Callback<void(const F &)>;
+    };
+
+    /**
+     * @brief Constructor, subscribes to the object once for all the member subscriptions
+     *
+     * @param object Object whose members are watched, must outlive the FieldSubscriber
+     * @param sub_d SubscribeDelegate holding the member subscriptions
+     */
+    FieldSubscriber(BaseData<T> &object, SubscribeDelegate<T> *sub_d) :
+        object(object), sub_d(sub_d), groups(nullptr)
+    {
+        object_sub = object.sub_internal([this](const T &next) {
+            bool any = false;
+            for (Group *group = groups; group; group = group->next) {
+                any |= group->update(next);
+            }
+            if (any) {
+                this->sub_d->notify(next, &this->object);
+            }
+        });
+    }
+
+    /**
+     * @brief Deleted Copy Constructor
+     *
+     */
+    FieldSubscriber(const FieldSubscriber &) = delete;
+
+    /**
+     * @brief Deleted Move Constructor, the object's subscription refers to this FieldSubscriber
+     *
+     */
+    FieldSubscriber(FieldSubscriber &&) = delete;
+
+    /**
+     * @brief Destructor, unsubscribes from the object
+     *
+     */
+    ~FieldSubscriber() {
+        object.unsub(object_sub);
+        while (groups) {
+            Group *next = groups->next;
+            Helper::destroy(groups);
+            groups = next;
+        }
+    }
+
+    /**
+     * @brief Subscribe to changes of one member
+     *
+     * @param member Pointer to the member, e.g. &Config::gain
+     * @param field_cb Callback called with the member's new value when it changes
+     * @return sub_id_t id to be used to unsub
+     */
+    template <typename F>
+    sub_id_t sub_field(F T::*member, typename field_cb_t<F>::type field_cb) {
+        struct Field {
+            FieldGroup<F> *group;
+            F T::*member;
+            typename field_cb_t<F>::type cb;
+        };
+        std::shared_ptr<Field> field = std::allocate_shared<Field>(Helper::Allocator<Field>(), Field{find_or_add(member), member, field_cb});
+        return sub_d->sub([field](const T &next) {
+            if (field->group->changed) {
+                field->cb(next.*(field->member));
+            }
+        });
+    }
+
+    /**
+     * @brief Unsubscribe a callback added with sub_field
+     *
+     * @param sub_id id returned by sub_field
+     */
+    void unsub(sub_id_t sub_id) {
+        sub_d->unsub(sub_id);
+        Helper::GetSubMonitor()->forget(&object, sub_id);
+    }
+private:
+    class Group {
+    public:
+        Group(size_t offset, const void *tag) :
+            next(nullptr), offset(offset), tag(tag), changed(false) { }
+
+        virtual ~Group() = default;
+
+        /**
+         * @brief Compare the member of next with the previous value and keep it
+         *
+         * @retval True if the member changed
+         */
+        virtual bool update(const T &next) = 0;
+
+        Group *next;
+        const size_t offset;
+        const void *tag; // Identifies the member's type
+        bool changed;    // Result of the last update
+    };
+
+    template <typename F>
+    class FieldGroup : public Group {
+    public:
+        FieldGroup(F T::*member, size_t offset, const F &prev) :
+            Group(offset, tag_of<F>()), member(member), prev(prev) { }
+
+        virtual bool update(const T &next) override final {
+            Group::changed = !(next.*member == prev);
+            if (Group::changed) {
+                prev = next.*member;
+            }
+            return Group::changed;
+        }
+    private:
+        F T::*member;
+        F prev;
+    };
+
+    template <typename F>
+    static const void *tag_of(void) {
+        static const char tag = 0;
+        return &tag;
+    }
+
+    template <typename F>
+    FieldGroup<F> *find_or_add(F T::*member) {
+        const T &value = object.get();
+        size_t offset = reinterpret_cast<const char *>(&(value.*member)) - reinterpret_cast<const char *>(&value);
+        for (Group *group = groups; group; group = group->next) {
+            if (group->offset == offset && group->tag == tag_of<F>()) {
+                return static_cast<FieldGroup<F> *>(group);
+            }
+        }
+        FieldGroup<F> *group = Helper::create<FieldGroup<F>>(member, offset, value.*member);
+        group->next = groups;
+        groups = group;
+        return group;
+    }
+
+    BaseData<T> &object;
+    SubscribeDelegate<T> *sub_d;
+    Group *groups;
+    sub_id_t object_sub;
+};
+
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 // Internal includes
+#include "Data/Helper/Function.hpp"
 
 // bwl component includes
 
@@ -11,6 +12,8 @@
 
 namespace Data {
 
+class BaseDataGeneric;
+
 /**
  * @brief Abstract interface who's implementations provide the means of subscribing,
  * unsubscribing and notifying subscribers
@@ -30,7 +33,7 @@ public:
      * @brief Callback function that is used when subscribers are notified
      *
      */
-    using sub_cb_t = std::function<void(const T &)>;
+    using sub_cb_t = Helper::Callback<void(const T &)>;
 
 
     /**
@@ -43,9 +46,11 @@ public:
      * @brief Subscribe to changes of a value
      *
      * @param sub_cb Callback function that is used when the value is changed
+     * @param internal Whether the callback is part of the library's own bookkeeping (e.g.
+     * MapData's or a queued subscription's), these are never timed by Helper::GetSubMonitor
      * @return sub_id_t The id used to unsubscribe this function
      */
-    virtual sub_id_t sub(sub_cb_t sub_cb) = 0;
+    virtual sub_id_t sub(sub_cb_t sub_cb, bool internal = false) = 0;
 
     /**
      * @brief Unsubscribe from changes of a value
@@ -58,8 +63,9 @@ public:
      * @brief Notify all subscribers that the value has changed
      *
      * @param value The new value to send to the subscribers
+     * @param src Object notifying, subscribers over Helper::GetSubMonitor's budget are recorded against it
      */
-    virtual void notify(const T &value) const = 0;
+    virtual void notify(const T &value, const BaseDataGeneric *src) const = 0;
 };
 
 };
@@ -2,12 +2,14 @@
 
 // Internal includes
 #include "Subscribe.hpp"
+#include "SubscribeMonitored.hpp"
 
 // bwl component includes
 
 // Esp-idf component includes
 
 // Standard library includes
+#include <cstdint>
 #include <functional>
 #include <vector>
 
@@ -29,7 +31,7 @@ public:
      *
      */
     SubscribeBasic(void) :
-        subs() { }
+        subs(), added(), notifying(0), removed(false) { }
 
     /**
      * @brief Destructor
@@ -39,31 +41,47 @@ public:
 
     /**
      * @brief Add the new sub callback to a vector
+     * @note A callback added while notifying is only called from the next notify
      *
      * @param sub_cb The new callback to add
+     * @param internal Whether the callback is never timed
      * @return sub_id_t The index of the new callback in the vector
      */
-    virtual sub_id_t sub(sub_cb_t sub_cb) override final {
+    virtual sub_id_t sub(sub_cb_t sub_cb, bool internal = false) override final {
+        if (notifying) {
+            added.push_back({sub_cb, true, internal, false});
+            return subs.size() + added.size() - 1;
+        }
+
         for (size_t i = 0; i < subs.size(); i++) {
-            if (subs[i] == nullptr) {
-                subs[i] = sub_cb;
+            if (subs[i].cb == nullptr) {
+                subs[i] = {sub_cb, true, internal, false};
                 return i;
             }
         }
 
         size_t id = subs.size();
-        subs.push_back(sub_cb);
+        subs.push_back({sub_cb, true, internal, false});
         return id;
     }
 
     /**
      * @brief Remove a callback from the vector of callbacks
+     * @note A callback removed while notifying is not called again, but is only
+     * destroyed once the notify has finished since it may be the one running
      *
      * @param sub_id The index of the callback to remove
      */
     virtual void unsub(sub_id_t sub_id) override final {
         if (sub_id < subs.size()) {
-            subs[sub_id] = nullptr;
+            if (notifying) {
+                subs[sub_id].active = false;
+                removed = true;
+            } else {
+                subs[sub_id] = {nullptr, false, false, false};
+            }
+        } else if (sub_id - subs.size() < added.size()) {
+            added[sub_id - subs.size()] = {nullptr, false, false, false};
         }
     }
 
@@ -71,16 +89,55 @@ public:
      * @brief Call all of the callback with 'value' as the parameter
      *
      * @param value The value to call all the callbacks with
+     * @param src Object notifying
      */
-    virtual void notify(const T &value) const override final {
+    virtual void notify(const T &value, const BaseDataGeneric *src) const override final {
+        notifying++;
         for (size_t i = 0; i < subs.size(); i++) {
-            if (subs[i]) {
-                subs[i](value);
+            if (!subs[i].active) continue;
+            if (subs[i].internal) {
+                subs[i].cb(value);
+            } else {
+                Helper::call_monitored<T>(subs[i].cb, subs[i].demoted, value, src, i);
             }
         }
+        notifying--;
+
+        if (notifying == 0) {
+            settle();
+        }
     }
 private:
-    std::vector<sub_cb_t> subs;
+    struct Entry {
+        sub_cb_t cb;
+        bool active;
+        bool internal;
+        bool demoted;  // Moved onto the SubMonitor's demotion executor
+    };
+
+    /**
+     * @brief Apply subs and unsubs that happened while notifying
+     *
+     */
+    void settle(void) const {
+        if (removed) {
+            for (Entry &entry : subs) {
+                if (!entry.active) {
+                    entry.cb = nullptr;
+                }
+            }
+            removed = false;
+        }
+        for (Entry &entry : added) {
+            subs.push_back(entry);
+        }
+        added.clear();
+    }
+
+    mutable std::vector<Entry> subs;
+    mutable std::vector<Entry> added;
+    mutable uint32_t notifying;
+    mutable bool removed;
 };
 
 };
@@ -0,0 +1,58 @@
+#pragma once
+
+// Internal includes
+#include "Subscribe.hpp"
+#include "SubscribeQueued.hpp"
+#include "Data/Helper/SubMonitor.hpp"
+#include "Data/Helper/Clock.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+
+// Standard library includes
+#include <cstddef>
+#include <cstdint>
+
+namespace Data {
+
+namespace Helper {
+
+/**
+ * @brief Call a subscriber from a SubscribeDelegate's notify, timed against the budget of
+ * GetSubMonitor when it has one
+ * @note A subscriber the monitor demotes has sub_cb replaced by a queued subscription on
+ * the demotion executor and isn't timed again. The budget is read on every call, so
+ * setting it times subscribers that were already subscribed.
+ *
+ * @param sub_cb The subscriber's callback
+ * @param demoted Whether the subscriber was demoted, set when it is
+ * @param value Value to call the callback with
+ * @param src Object notifying
+ * @param sub_id Id of the subscriber
+ */
+template <typename T>
+void call_monitored(typename SubscribeDelegate<T>::sub_cb_t &sub_cb, bool &demoted, const T &value,
+        const BaseDataGeneric *src, size_t sub_id) {
+    SubMonitor *monitor = GetSubMonitor();
+    uint32_t budget_us = monitor->get_budget_us();
+    if (budget_us == 0 || demoted) {
+        sub_cb(value);
+        return;
+    }
+
+    int64_t start = now_us();
+    sub_cb(value);
+    uint32_t us = (uint32_t)(now_us() - start);
+    if (us > budget_us) {
+        Executor *executor = monitor->record(src, sub_id, us);
+        if (executor) {
+            sub_cb = make_queued<T>(sub_cb, *executor, 4, Overflow::DROP_OLDEST);
+            demoted = true;
+        }
+    }
+}
+
+};
+
+};
@@ -0,0 +1,174 @@
+#pragma once
+
+// Internal includes
+#include "Subscribe.hpp"
+#include "Data/Executor/Executor.hpp"
+#include "Data/Helper/BoundedQueue.hpp"
+#include "Data/Helper/Arena.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+#include "FreeRTOS/FreeRTOS.h"
+#include "FreeRTOS/task.h"
+
+// Standard library includes
+#include <atomic>
+#include <memory>
+
+#ifndef CONFIG_DATA_QUEUED_BLOCK_MS
+#define CONFIG_DATA_QUEUED_BLOCK_MS 10
+#endif
+
+namespace Data {
+
+/**
+ * @brief What a queued subscription does when its queue is full
+ *
+ */
+enum class Overflow {
+    DROP_OLDEST, // Discard the oldest queued value to make room
+    COALESCE,    // Only keep the newest value, older ones that weren't delivered are discarded
+    BLOCK,       // Wait in notify until the executor makes room, drops the oldest value
+                 // instead when notify runs on the executor's own task or the drain
+                 // can't be posted for CONFIG_DATA_QUEUED_BLOCK_MS
+};
+
+namespace Helper {
+
+/**
+ * @brief Queue of values between a notify and a callback run on an Executor
+ * @note Values are copied once into the queue and handed to the callback in place
+ *
+ * @tparam T Type subscribers are notified with
+ */
+template <typename T>
+class QueuedChannel : public std::enable_shared_from_this<QueuedChannel<T>> {
+public:
+    using sub_cb_t = typename SubscribeDelegate<T>::sub_cb_t;
+
+    /**
+     * @brief Constructor
+     *
+     * @param sub_cb Callback to run on the executor
+     * @param executor Executor to run the callback on
+     * @param depth Number of values that can be queued
+     * @param overflow What to do when the queue is full
+     */
+    QueuedChannel(sub_cb_t sub_cb, Executor &executor, size_t depth, Overflow overflow) :
+        sub_cb(sub_cb), executor(executor), queue(depth), overflow(overflow),
+        self(), scheduled(false), closed(false), dropped(0) { }
+
+    /**
+     * @brief Queue a value and schedule the callback, called from notify
+     *
+     * @param value The value to queue
+     */
+    void push(const T &value) {
+        if (overflow == Overflow::COALESCE) {
+            while (queue.try_drop()) {
+                dropped++;
+            }
+        }
+        // Waiting on the task that drains the queue would never end
+        bool block = overflow == Overflow::BLOCK && !executor.is_current();
+        TickType_t unposted = 0;
+        while (!queue.try_push(value)) {
+            // Room is only made by a drain, so one must be posted before waiting
+            if (block && schedule()) {
+                vTaskDelay(1);
+            } else if (block && unposted < pdMS_TO_TICKS(CONFIG_DATA_QUEUED_BLOCK_MS)) {
+                vTaskDelay(1);
+                unposted++;
+            } else if (queue.try_drop()) {
+                dropped++;
+            }
+        }
+
+        // When the post fails the next push tries again
+        schedule();
+    }
+
+    /**
+     * @brief Stop calling the callback, values still queued are discarded
+     *
+     */
+    void close(void) {
+        closed = true;
+    }
+
+    /**
+     * @brief Get the number of values discarded by the overflow policy
+     */
+    uint32_t get_dropped(void) const {
+        return dropped;
+    }
+private:
+    /**
+     * @brief Post a drain unless one is already posted
+     *
+     * @retval True if a drain is posted
+     */
+    bool schedule(void) {
+        if (scheduled.exchange(true)) {
+            return true;
+        }
+        self = this->shared_from_this();
+        if (!executor.post(&QueuedChannel::drain, this)) {
+            self = nullptr;
+            scheduled = false;
+            return false;
+        }
+        return true;
+    }
+
+    static void drain(void *arg) {
+        QueuedChannel *channel = static_cast<QueuedChannel *>(arg);
+        std::shared_ptr<QueuedChannel> keep = std::move(channel->self);
+        channel->scheduled = false;
+        while (channel->queue.try_pop([channel](T &value) {
+            if (!channel->closed) {
+                channel->sub_cb(value);
+            }
+        })) { }
+    }
+
+    sub_cb_t sub_cb;
+    Executor &executor;
+    BoundedQueue<T> queue;
+    const Overflow overflow;
+    std::shared_ptr<QueuedChannel> self; // Keeps the channel alive while a drain is posted
+    std::atomic<bool> scheduled;
+    std::atomic<bool> closed;
+    std::atomic<uint32_t> dropped;
+};
+
+/**
+ * @brief Wrap a callback so notify queues the value and the callback runs on an executor
+ * @note The channel is closed once every copy of the returned callback is destroyed,
+ * i.e. when the subscriber unsubscribes
+ *
+ * @param sub_cb Callback to run on the executor
+ * @param executor Executor to run the callback on
+ * @param depth Number of values that can be queued
+ * @param overflow What to do when the queue is full
+ */
+template <typename T>
+typename SubscribeDelegate<T>::sub_cb_t make_queued(typename SubscribeDelegate<T>::sub_cb_t sub_cb,
+        Executor &executor, size_t depth, Overflow overflow) {
+    struct Subscription {
+        std::shared_ptr<QueuedChannel<T>> channel;
+        ~Subscription() {
+            channel->close();
+        }
+    };
+    std::shared_ptr<Subscription> subscription = std::allocate_shared<Subscription>(Allocator<Subscription>());
+    subscription->channel = std::allocate_shared<QueuedChannel<T>>(Allocator<QueuedChannel<T>>(), sub_cb, executor, depth, overflow);
+    return [subscription](const T &value) {
+        subscription->channel->push(value);
+    };
+}
+
+};
+
+};
@@ -0,0 +1,147 @@
+#pragma once
+
+// Internal includes
+#include "Subscribe.hpp"
+#include "SubscribeMonitored.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+#include "esp_log.h"
+
+// Standard library includes
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+namespace Data {
+
+namespace Helper {
+
+/**
+ * @brief Most subscribers held at once by any SubscribeStatic
+ */
+inline std::atomic<size_t> &sub_high_water(void) {
+    static std::atomic<size_t> high_water(0);
+    return high_water;
+}
+
+};
+
+/**
+ * @brief SubscribeDelegate with a fixed size table of callbacks held inline
+ * @note Built with CONFIG_DATA_NO_HEAP callbacks are Helper::Callback, held inline in the
+ * table, so subscribing never allocates. Subscribing to a full table fails and returns SIZE_MAX.
+ *
+ * @tparam T Type subscribers are notified with
+ * @tparam N Maximum number of subscribers
+ */
+template <typename T, size_t N>
+class SubscribeStatic : public SubscribeDelegate<T> {
+    static_assert(N > 0, "SubscribeStatic capacity must be at least 1");
+public:
+    using sub_id_t = typename SubscribeDelegate<T>::sub_id_t;
+    using sub_cb_t = typename SubscribeDelegate<T>::sub_cb_t;
+
+    /**
+     * @brief Constructor
+     *
+     */
+    SubscribeStatic(void) :
+        subs(), used(0), notifying(0) { }
+
+    /**
+     * @brief Destructor
+     *
+     */
+    virtual ~SubscribeStatic() = default;
+
+    /**
+     * @brief Add the new sub callback to the first free entry of the table
+     * @note A callback added while notifying is only called from the next notify
+     *
+     * @param sub_cb The new callback to add
+     * @param internal Whether the callback is never timed
+     * @return sub_id_t The index of the new callback in the table, SIZE_MAX if the table is full
+     */
+    virtual sub_id_t sub(sub_cb_t sub_cb, bool internal = false) override final {
+        for (size_t i = 0; i < N; i++) {
+            if (subs[i].state == State::FREE) {
+                subs[i] = {sub_cb, notifying ? State::ADDED : State::ACTIVE, internal, false};
+                used++;
+                size_t high_water = Helper::sub_high_water().load();
+                while (used > high_water && !Helper::sub_high_water().compare_exchange_weak(high_water, used)) { }
+                return i;
+            }
+        }
+        ESP_LOGE("SubscribeStatic", "Subscriber table of %u is full", (unsigned)N);
+        return SIZE_MAX;
+    }
+
+    /**
+     * @brief Remove a callback from the table
+     * @note A callback removed while notifying is only destroyed once the notify has finished
+     *
+     * @param sub_id The index of the callback to remove
+     */
+    virtual void unsub(sub_id_t sub_id) override final {
+        if (sub_id < N && subs[sub_id].state != State::FREE) {
+            if (notifying) {
+                subs[sub_id].state = State::REMOVED;
+            } else {
+                subs[sub_id] = {nullptr, State::FREE, false, false};
+                used--;
+            }
+        }
+    }
+
+    /**
+     * @brief Call all of the callback with 'value' as the parameter
+     *
+     * @param value The value to call all the callbacks with
+     * @param src Object notifying
+     */
+    virtual void notify(const T &value, const BaseDataGeneric *src) const override final {
+        notifying++;
+        for (size_t i = 0; i < N; i++) {
+            if (subs[i].state != State::ACTIVE) continue;
+            if (subs[i].internal) {
+                subs[i].cb(value);
+            } else {
+                Helper::call_monitored<T>(subs[i].cb, subs[i].demoted, value, src, i);
+            }
+        }
+        notifying--;
+
+        if (notifying == 0) {
+            for (Entry &entry : subs) {
+                if (entry.state == State::REMOVED) {
+                    entry = {nullptr, State::FREE, false, false};
+                    used--;
+                } else if (entry.state == State::ADDED) {
+                    entry.state = State::ACTIVE;
+                }
+            }
+        }
+    }
+private:
+    enum class State : uint8_t {
+        FREE,
+        ACTIVE,
+        ADDED,   // Subscribed while notifying
+        REMOVED, // Unsubscribed while notifying
+    };
+
+    struct Entry {
+        sub_cb_t cb;
+        State state;
+        bool internal;
+        bool demoted;  // Moved onto the SubMonitor's demotion executor
+    };
+
+    mutable Entry subs[N];
+    mutable size_t used;
+    mutable uint32_t notifying;
+};
+
+};
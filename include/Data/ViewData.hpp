@@ -0,0 +1,63 @@
+#pragma once
+
+// Internal includes
+#include "BaseData.hpp"
+#include "Storage/StorageMapped.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+
+// Standard library includes
+
+namespace Data {
+
+/**
+ * @brief Read-only view of a large, mostly constant table such as a lookup curve,
+ * read in place from flash when it can be mapped
+ * @note The view stays valid until the next load_or_reset or reset
+ *
+ * @tparam T Type of the table's elements
+ */
+template <typename T>
+class ViewData : public BaseData<Helper::Span<const T>> {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param sub_d SubscribeDelegate to use for subscribing
+     * @param store_d StorageMapped the table is read through
+     */
+    ViewData(SubscribeDelegate<Helper::Span<const T>> *sub_d, StorageMapped<T> *store_d, const char *name) :
+        BaseData<Helper::Span<const T>>(sub_d, store_d, name), mapped_d(store_d) { }
+
+    /**
+     * @brief Deleted Copy Constructor
+     *
+     */
+    ViewData(const ViewData &) = delete;
+
+    /**
+     * @brief Default Move Constructor
+     *
+     */
+    ViewData(ViewData &&) = default;
+
+    /**
+     * @brief Whether or not the table is read in place rather than from a copy in RAM
+     */
+    bool is_mapped(void) const {
+        return mapped_d->get_blob().is_mapped();
+    }
+
+    /**
+     * @brief Check the table against its header's crc, a full read of the table
+     */
+    bool verify(void) const {
+        return mapped_d->get_blob().verify();
+    }
+private:
+    const StorageMapped<T> *mapped_d;
+};
+
+};
@@ -0,0 +1,283 @@
+#pragma once
+
+// Internal includes
+
+// bwl component includes
+#include "Data/BaseData.hpp"
+#include "Data/Set/SetBounded.hpp"
+#include "Data/Helper/Span.hpp"
+#include "Data/Helper/Writer.hpp"
+
+// Esp-idf component includes
+
+// Standard library includes
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+namespace Data {
+
+class Model;
+
+/**
+ * @brief Type of the value held by a described object
+ *
+ */
+enum class TypeId : uint8_t {
+    UNKNOWN, // Not trivially copyable, only reachable through the object
+    BOOL,
+    INT8,
+    UINT8,
+    INT16,
+    UINT16,
+    INT32,
+    UINT32,
+    INT64,
+    UINT64,
+    FLOAT,
+    DOUBLE,
+    STRING,  // std::string
+    BLOB,    // Any other trivially copyable type, e.g. a struct
+};
+
+/**
+ * @brief Get the TypeId of T
+ */
+template <typename T>
+constexpr TypeId type_id_of(void) {
+    using U = typename std::conditional<std::is_enum<T>::value, std::underlying_type<T>, std::common_type<T>>::type::type;
+    if constexpr (std::is_same<U, bool>::value) return TypeId::BOOL;
+    else if constexpr (std::is_integral<U>::value && std::is_signed<U>::value) {
+        return sizeof(U) == 1 ? TypeId::INT8 : sizeof(U) == 2 ? TypeId::INT16 : sizeof(U) == 4 ? TypeId::INT32 : TypeId::INT64;
+    } else if constexpr (std::is_integral<U>::value) {
+        return sizeof(U) == 1 ? TypeId::UINT8 : sizeof(U) == 2 ? TypeId::UINT16 : sizeof(U) == 4 ? TypeId::UINT32 : TypeId::UINT64;
+    }
+    else if constexpr (std::is_same<U, float>::value) return TypeId::FLOAT;
+    else if constexpr (std::is_same<U, double>::value) return TypeId::DOUBLE;
+    else if constexpr (std::is_same<U, std::string>::value) return TypeId::STRING;
+    else if constexpr (std::is_trivially_copyable<U>::value && !Helper::is_span<U>::value) return TypeId::BLOB;
+    else return TypeId::UNKNOWN;
+}
+
+/**
+ * @brief Compile-time description of one object of a Model, see describe
+ * @note default_value, min and max only mean something for arithmetic types
+ *
+ */
+struct Descriptor {
+    // Fields that don't match the object, returned by check
+    static constexpr uint8_t NVS_KEY_MISMATCH = 1 << 0;
+    static constexpr uint8_t DEFAULT_MISMATCH = 1 << 1;
+    static constexpr uint8_t BOUNDS_MISMATCH = 1 << 2;
+
+    const char *name;
+    const char *nvs_key;        // nullptr if the object isn't stored
+    TypeId type;
+    uint16_t size;              // Bytes of the value, 0 for STRING and UNKNOWN
+    bool bounded;               // Whether or not min and max apply
+    double default_value;
+    double min;                 // Inclusive
+    double max;                 // Exclusive
+    BaseDataGeneric &(*object)(Model &model);
+    const void *(*value)(const Model &model); // The value's bytes, valid until it is next set
+    uint8_t (*check)(const Model &model, const Descriptor &descriptor); // Mismatches with the object
+
+    /**
+     * @brief Get the default value as the object's type, for passing to the Factory
+     */
+    template <typename T>
+    constexpr T get_default(void) const {
+        return static_cast<T>(default_value);
+    }
+
+    template <typename T>
+    constexpr T get_min(void) const {
+        return static_cast<T>(min);
+    }
+
+    template <typename T>
+    constexpr T get_max(void) const {
+        return static_cast<T>(max);
+    }
+};
+
+namespace Helper {
+
+template <typename P>
+struct member_of;
+
+template <typename M, typename D>
+struct member_of<D M::*> {
+    using model_t = M;
+    using data_t = D;
+    using value_t = typename D::value_type;
+};
+
+template <auto member>
+BaseDataGeneric &described_object(Model &model) {
+    using model_t = typename member_of<decltype(member)>::model_t;
+    return static_cast<model_t &>(model).*member;
+}
+
+template <auto member>
+const void *described_value(const Model &model) {
+    using model_t = typename member_of<decltype(member)>::model_t;
+    return &(static_cast<const model_t &>(model).*member).get();
+}
+
+/**
+ * @brief Compare a descriptor with its object's nvs key, default value for arithmetic
+ * types and bounds when the object is a BoundedObject
+ *
+ * @return uint8_t The Descriptor::*_MISMATCH of the fields that differ
+ */
+template <auto member>
+uint8_t described_check(const Model &model, const Descriptor &descriptor) {
+    using model_t = typename member_of<decltype(member)>::model_t;
+    using data_t = typename member_of<decltype(member)>::data_t;
+    using value_t = typename member_of<decltype(member)>::value_t;
+    const data_t &data = static_cast<const model_t &>(model).*member;
+    uint8_t mismatch = 0;
+
+    const char *nvs_key = data.get_nvs_key();
+    if (nvs_key == nullptr || descriptor.nvs_key == nullptr ?
+            nvs_key != descriptor.nvs_key : std::strcmp(nvs_key, descriptor.nvs_key) != 0) {
+        mismatch |= Descriptor::NVS_KEY_MISMATCH;
+    }
+    if constexpr (std::is_arithmetic<value_t>::value || std::is_enum<value_t>::value) {
+        if (data.get_default() != descriptor.get_default<value_t>()) {
+            mismatch |= Descriptor::DEFAULT_MISMATCH;
+        }
+    }
+    if constexpr (std::is_base_of<BoundedObject<value_t>, data_t>::value) {
+        if (!descriptor.bounded || data.get_min() != descriptor.get_min<value_t>() ||
+                data.get_max() != descriptor.get_max<value_t>()) {
+            mismatch |= Descriptor::BOUNDS_MISMATCH;
+        }
+    }
+    return mismatch;
+}
+
+};
+
+/**
+ * @brief Describe an object of a Model
+ *
+ * @tparam member Pointer to the object, e.g. &Pid::mode
+ * @param name Name of the object
+ * @param nvs_key Key the object is stored under, nullptr if it isn't stored
+ * @param default_value Default value of arithmetic types
+ */
+template <auto member>
+constexpr Descriptor describe(const char *name, const char *nvs_key, double default_value = 0) {
+    using value_t = typename Helper::member_of<decltype(member)>::value_t;
+    constexpr TypeId type = type_id_of<value_t>();
+    return Descriptor{
+        name, nvs_key, type,
+        (uint16_t)(type == TypeId::UNKNOWN || type == TypeId::STRING ? 0 : sizeof(value_t)),
+        false, default_value, 0, 0,
+        &Helper::described_object<member>, &Helper::described_value<member>,
+        &Helper::described_check<member>,
+    };
+}
+
+/**
+ * @brief Describe a bounded object of a Model, e.g. a SetBoundedData
+ *
+ * @param min Minimum valid value inclusive
+ * @param max Maximum valid value exclusive
+ */
+template <auto member>
+constexpr Descriptor describe(const char *name, const char *nvs_key, double default_value, double min, double max) {
+    Descriptor descriptor = describe<member>(name, nvs_key, default_value);
+    descriptor.bounded = true;
+    descriptor.min = min;
+    descriptor.max = max;
+    return descriptor;
+}
+
+/**
+ * @brief Collect descriptors into the table a Model returns from a static constexpr describe()
+ */
+template <typename... D>
+constexpr std::array<Descriptor, sizeof...(D)> make_descriptors(const D &... descriptors) {
+    return {{descriptors...}};
+}
+
+/**
+ * @brief Holds the table of M, evaluated once at compile time from M::describe()
+ *
+ * @tparam M Model type with a static constexpr describe()
+ */
+template <typename M>
+struct DescriptorTable {
+    static constexpr auto table = M::describe();
+};
+
+namespace Helper {
+
+/**
+ * @brief Check every descriptor of a table against its object, logging the mismatches
+ *
+ * @retval False if any descriptor doesn't match its object
+ */
+bool check_descriptors(const Model &model, Span<const Descriptor> table);
+
+};
+
+/**
+ * @brief Get the descriptor table of M, e.g. to return from Model::get_descriptors
+ * @note The first call checks the table against model's objects, see Helper::check_descriptors
+ *
+ * @param model Model the table describes
+ */
+template <typename M>
+Helper::Span<const Descriptor> descriptors_of(const M &model) {
+    Helper::Span<const Descriptor> table(DescriptorTable<M>::table.data(), DescriptorTable<M>::table.size());
+    static const bool checked = Helper::check_descriptors(model, table);
+    (void)checked;
+    return table;
+}
+
+namespace Helper {
+
+/**
+ * @brief Find a descriptor by name
+ *
+ * @return const Descriptor* The descriptor, nullptr if there is none with the name
+ */
+const Descriptor *find_descriptor(Span<const Descriptor> table, const char *name);
+
+/**
+ * @brief Write the values of a model from its descriptors, "name: value" lines or a JSON object
+ * @note Values are read straight from their bytes, UNKNOWN types go through the object
+ */
+void export_described(const Model &model, Span<const Descriptor> table, Writer &writer, uint32_t depth = 0);
+
+/**
+ * @brief Number of bytes encode_described writes
+ */
+size_t described_size(Span<const Descriptor> table);
+
+/**
+ * @brief Copy the values with a size one after the other into buf
+ *
+ * @return size_t Number of bytes written, 0 if buf is too small
+ */
+size_t encode_described(const Model &model, Span<const Descriptor> table, uint8_t *buf, size_t buf_sz);
+
+/**
+ * @brief Decode values written by encode_described, setting each through its object's
+ * set_encoded so it is checked and locked like a set or edit, then storing it
+ * @note A value its object rejects (e.g. out of bounds) is skipped
+ *
+ * @retval False if buf isn't the size encode_described writes, nothing was decoded
+ */
+bool decode_described(Model &model, Span<const Descriptor> table, const uint8_t *buf, size_t buf_sz);
+
+};
+
+};
@@ -0,0 +1,180 @@
+#pragma once
+
+// Internal includes
+#include "Model.hpp"
+#include "Descriptor.hpp"
+
+// bwl component includes
+#include "Data/Helper/NvsHandler.hpp"
+
+// Esp-idf component includes
+#include "sdkconfig.h"
+
+// Standard library includes
+#include <cstddef>
+#include <cstdint>
+
+#ifndef CONFIG_DATA_IMPORT_KEY_SIZE
+#define CONFIG_DATA_IMPORT_KEY_SIZE 64
+#endif
+
+#ifndef CONFIG_DATA_IMPORT_VALUE_SIZE
+#define CONFIG_DATA_IMPORT_VALUE_SIZE 128
+#endif
+
+#ifndef CONFIG_DATA_IMPORT_MAX_OBJECTS
+#define CONFIG_DATA_IMPORT_MAX_OBJECTS 32
+#endif
+
+namespace Data {
+
+/**
+ * @brief Streams a config into a model without allocating, as "pid.kp = 1.5" lines or as
+ * a JSON object of nested objects and values, the format is picked from the first character
+ * @note Keys are the names of child models joined with '.' and ending with the name of a
+ * described object, see Model::get_descriptors. Objects are muted when first set, so
+ * their subscribers are notified once with the final value by finish, which then
+ * stores each object once and commits every nvs handler they are stored with. Values are
+ * checked against the descriptor's bounds and set with the object's set_encoded, so its
+ * SetDelegate checks them too. Objects set beyond CONFIG_DATA_IMPORT_MAX_OBJECTS are
+ * notified and stored on every value. Arrays aren't supported and blobs are hex like
+ * export_described writes them.
+ *
+ */
+class Importer {
+public:
+    /**
+     * @brief Why the import stopped or a value was skipped
+     *
+     */
+    enum class Error : uint8_t {
+        NONE,
+        SYNTAX,        // The import stopped
+        UNKNOWN_KEY,   // No described object at the key
+        BAD_VALUE,     // The value doesn't parse as the object's type
+        OUT_OF_BOUNDS, // The value is outside the descriptor's bounds
+        TOO_LONG,      // The key or value doesn't fit its buffer
+        REJECTED,      // The object's SetDelegate rejected the value, e.g. its bounds
+        TOO_MANY_HANDLERS, // The object's nvs handler is past the MAX_HANDLERS finish commits
+    };
+
+    /**
+     * @brief Constructor
+     *
+     * @param root Model the keys start from, must outlive the Importer
+     */
+    Importer(Model &root);
+
+    Importer(const Importer &) = delete;
+
+    /**
+     * @brief Destructor, calls finish if it wasn't
+     *
+     */
+    ~Importer();
+
+    /**
+     * @brief Parse the next chunk of the config, values are set as soon as they end
+     *
+     * @param data Chunk of the config
+     * @param data_sz Size of the chunk
+     * @retval False once the config has a syntax error, nothing more is parsed
+     */
+    bool feed(const char *data, size_t data_sz);
+
+    /**
+     * @brief End the import, notify the subscribers of every object set, store them and commit
+     *
+     * @retval False if the config had a syntax error or ended inside a JSON object,
+     * the values set before it are kept
+     */
+    bool finish(void);
+
+    /**
+     * @brief Number of values set
+     */
+    size_t get_set_count(void) const;
+
+    /**
+     * @brief Number of values skipped, see get_error
+     */
+    size_t get_skipped_count(void) const;
+
+    /**
+     * @brief Get the syntax error that stopped the import, otherwise why the first value
+     * was skipped, NONE if every value was set
+     */
+    Error get_error(void) const;
+
+    /**
+     * @brief Get the line of the error returned by get_error, counting from 1
+     */
+    uint32_t get_error_line(void) const;
+private:
+    static constexpr size_t MAX_DEPTH = 8;    // Nesting of JSON objects
+    static constexpr size_t MAX_HANDLERS = 4; // Nvs handlers committed by finish
+
+    enum class State : uint8_t {
+        START,
+        // key=value
+        KV_LINE,
+        KV_KEY,
+        KV_VALUE,
+        KV_COMMENT,
+        // JSON
+        JSON_KEY_START,
+        JSON_KEY,
+        JSON_KEY_ESCAPE,
+        JSON_COLON,
+        JSON_VALUE,
+        JSON_STRING,
+        JSON_STRING_ESCAPE,
+        JSON_SCALAR,
+        JSON_NEXT,
+        DONE,
+        FAILED,
+    };
+
+    bool step(char c);
+    void end_kv_line(void);
+    void push_key(char c);
+    void push_value(char c);
+    void apply(void);
+    void skip(Error error);
+    bool is_unchanged(const BaseDataGeneric &object, const uint8_t *data, size_t data_sz) const;
+
+    /**
+     * @brief Object set by the import, unmuted and stored by finish
+     *
+     */
+    struct Touched {
+        BaseDataGeneric *object;
+        bool muted;   // Muted by the import rather than already muted
+        bool changed; // Needs storing
+    };
+
+    bool touch(BaseDataGeneric &object);
+    Touched *find_touched(const BaseDataGeneric &object);
+
+    Model &root;
+    State state;
+    bool finished;
+    bool overflow;    // The key or value being read didn't fit
+    char key[CONFIG_DATA_IMPORT_KEY_SIZE];
+    size_t key_sz;
+    char value[CONFIG_DATA_IMPORT_VALUE_SIZE];
+    size_t value_sz;
+    size_t depth;     // Nesting of JSON objects
+    size_t bases[MAX_DEPTH]; // Length of the key each JSON object's keys follow
+    uint32_t line;
+    size_t set_count;
+    size_t skipped_count;
+    Error error;
+    uint32_t error_line;
+    Touched touched[CONFIG_DATA_IMPORT_MAX_OBJECTS];
+    size_t touched_count;
+    Helper::NvsHandler *handlers[MAX_HANDLERS];
+    size_t handler_count;
+};
+
+};
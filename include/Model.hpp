@@ -1,13 +1,22 @@
 #pragma once
 
 // Internal includes
+#include "Descriptor.hpp"
+#include "Data/Helper/Function.hpp"
 
 // bwl component includes
 #include "Data/BaseData.hpp"
+#include "Data/Helper/ObjectArena.hpp"
+#include "Data/Helper/NvsHandler.hpp"
 
 // Esp-idf component includes
+#include "FreeRTOS/FreeRTOS.h"
+#include "FreeRTOS/semphr.h"
+#include "FreeRTOS/task.h"
 
 // Standard library includes
+#include <atomic>
+#include <cstring>
 #include <vector>
 
 namespace Data{
@@ -17,8 +26,152 @@ namespace Data{
  */
 class Model : public BaseDataGeneric {
 public:
+    /**
+     * @brief Batch of writes to the model's objects that readers see all at once or not
+     * at all, see read
+     * @note A model and its child models share the epoch of the root model, so reading
+     * a parent retries when a child's transaction commits. Transactions of the same tree
+     * of models run one at a time and don't nest. Don't call read on any model of the
+     * tree from inside one, it waits for the transaction to commit.
+     *
+     */
+    class Transaction {
+    public:
+        /**
+         * @brief Constructor, waits for other transactions and makes the root's epoch
+         * odd so readers retry until commit
+         *
+         * @param model Model whose objects are written
+         */
+        Transaction(Model &model) :
+            model(&model.get_root())
+        {
+            xSemaphoreTake(this->model->write_sem, portMAX_DELAY);
+            this->model->epoch.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+
+        Transaction(const Transaction &) = delete;
+
+        /**
+         * @brief Destructor, commits if commit wasn't called
+         *
+         */
+        ~Transaction() {
+            commit();
+        }
+
+        /**
+         * @brief Publish the writes by making the epoch even again
+         *
+         */
+        void commit(void) {
+            if (model) {
+                model->epoch.fetch_add(1, std::memory_order_release);
+                xSemaphoreGive(model->write_sem);
+                model = nullptr;
+            }
+        }
+    private:
+        Model *model; // Root of the model written
+    };
+
     // Model() : BaseDataGeneric("Model") {}
-    Model(const char *name) : BaseDataGeneric(name) {}
+    Model(const char *name) : BaseDataGeneric(name), arena(), parent(nullptr), epoch(0)
+    {
+#if CONFIG_DATA_NO_HEAP
+        write_sem = xSemaphoreCreateMutexStatic(&write_sem_buf);
+#else
+        write_sem = xSemaphoreCreateMutex();
+#endif
+    }
+
+    ~Model() {
+        vSemaphoreDelete(write_sem);
+    }
+
+    /**
+     * @brief Start a batch of writes that readers see together
+     */
+    Transaction transact(){
+        return Transaction(*this);
+    }
+
+    /**
+     * @brief Run fn until it has read the model's objects without a transaction of its
+     * tree of models committing in between, so what it copied out is consistent
+     * @note Takes no lock, fn runs again if it raced a transaction so it should only copy
+     * values out, and only trivially copyable ones since a writer may be changing them
+     *
+     * @param fn Function copying the values it needs
+     * @return uint32_t Epoch of the values read
+     */
+    template <typename F>
+    uint32_t read(F &&fn) const {
+        uint32_t begin;
+        do {
+            begin = read_begin();
+            fn();
+        } while (read_retry(begin));
+        return begin;
+    }
+
+    /**
+     * @brief Wait until no transaction is open and get the epoch, for reads spread over
+     * code that can't be put into a function, see read_retry
+     */
+    uint32_t read_begin(void) const {
+        const std::atomic<uint32_t> &root_epoch = get_root().epoch;
+        uint32_t begin = root_epoch.load(std::memory_order_acquire);
+        for (uint32_t i = 0; begin & 1; i++) {
+            if (i < READ_SPINS) {
+                // A writer on the other core commits within a few loads
+            } else if (i < READ_SPINS + READ_YIELDS) {
+                taskYIELD();
+            } else {
+                // Let a lower priority writer finish rather than spin over it
+                vTaskDelay(1);
+            }
+            begin = root_epoch.load(std::memory_order_acquire);
+        }
+        return begin;
+    }
+
+    /**
+     * @brief Whether or not a transaction committed since read_begin returned begin,
+     * in which case the values read must be read again
+     */
+    bool read_retry(uint32_t begin) const {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return get_root().epoch.load(std::memory_order_relaxed) != begin;
+    }
+
+    /**
+     * @brief Number of transactions of the tree of models opened and committed times two,
+     * odd while one is open
+     */
+    uint32_t get_epoch(void) const {
+        return get_root().epoch.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Get the descriptor table of the model's own objects, empty unless the model
+     * overrides it, typically with descriptors_of(*this)
+     */
+    virtual Helper::Span<const Descriptor> get_descriptors(void) const {
+        return {};
+    }
+
+    /**
+     * @brief Call fn with every object holding a value in this model and its child models
+     *
+     * @param fn Function called with each object
+     */
+    virtual void for_each(const Helper::Callback<void(BaseDataGeneric &)> &fn) override {
+        for(auto data : datas){
+            data->for_each(fn);
+        }
+    }
 
     void reset() {
         for(auto data : datas){
@@ -39,14 +192,78 @@ public:
     }
 
     void print(uint32_t indent_depth = 0){
-        for(int i = 0; i < indent_depth; i++)
-            std::cout << "  ";
-        std::cout << name << '\n';
-        for(auto data : datas){
-            data->print(indent_depth + 1);
+        Helper::StdoutSink sink;
+        Helper::Writer writer(sink);
+        export_to(writer, indent_depth);
+    }
+
+    /**
+     * @brief Write the model's name followed by its children, or a JSON object of its children
+     */
+    void export_to(Helper::Writer &writer, uint32_t depth = 0) const{
+        if(writer.get_mode() == Helper::Writer::Mode::JSON){
+            if(depth > 0){
+                writer.put_string(name ? name : "");
+                writer.put(':');
+            }
+            writer.put('{');
+            for(size_t i = 0; i < datas.size() && !writer.is_full(); i++){
+                if(i > 0) writer.put(',');
+                datas[i]->export_to(writer, depth + 1);
+            }
+            writer.put('}');
+        } else {
+            writer.put_indent(depth);
+            writer.put(name ? name : "");
+            writer.put('\n');
+            for(size_t i = 0; i < datas.size() && !writer.is_full(); i++){
+                datas[i]->export_to(writer, depth + 1);
+            }
         }
     }
 
+    /**
+     * @brief Print the flash writes of every object stored in nvs, see NvsHandler::KeyStats
+     */
+    void print_wear(uint32_t indent_depth = 0){
+        Helper::StdoutSink sink;
+        Helper::Writer writer(sink);
+        export_wear(writer, indent_depth);
+    }
+
+    /**
+     * @brief Write "name (key): stores=.." lines for every object stored in nvs, or a JSON
+     * object of the objects' stats keyed by name
+     */
+    void export_wear(Helper::Writer &writer, uint32_t depth = 0){
+        bool json = writer.get_mode() == Helper::Writer::Mode::JSON;
+        bool first = true;
+        if(json) writer.put('{');
+        for_each([&](BaseDataGeneric &data){
+            const char *key = data.get_nvs_key();
+            Helper::NvsHandler *handler = data.get_nvs_handler();
+            if(key == nullptr || handler == nullptr){
+                return;
+            }
+            if(json){
+                if(!first) writer.put(',');
+                writer.put_string(data.get_name() ? data.get_name() : key);
+                writer.put(':');
+                handler->export_key_stats(writer, key);
+            } else {
+                writer.put_indent(depth);
+                writer.put(data.get_name() ? data.get_name() : "");
+                writer.put(" (");
+                writer.put(key);
+                writer.put("): ");
+                handler->export_key_stats(writer, key);
+                writer.put('\n');
+            }
+            first = false;
+        });
+        if(json) writer.put('}');
+    }
+
     void log_on_sub(bool set = true){
         for(auto data : datas){
             data->log_on_sub(set);
@@ -65,13 +282,71 @@ public:
         }
     }
 
+    /**
+     * @brief Find a child model by name
+     *
+     * @param name Name of the child, needn't be null terminated
+     * @param name_sz Length of name
+     * @return Model* The child, nullptr if there is none with the name
+     */
+    Model *find_model(const char *name, size_t name_sz){
+        for(auto model : models){
+            const char *model_name = model->get_name();
+            if(model_name && std::strncmp(model_name, name, name_sz) == 0 && model_name[name_sz] == '\0'){
+                return model;
+            }
+        }
+        return nullptr;
+    }
+
 protected:
     void add_data(BaseDataGeneric &data){
         datas.push_back(&data);
     }
 
+    void add_data(Model &model){
+        datas.push_back(&model);
+        models.push_back(&model);
+        model.parent = this;
+    }
+
+    /**
+     * @brief Get the arena to pass to the Factory for this model's objects, their delegates
+     * are destroyed with the model after the objects themselves
+     */
+    Helper::ObjectArena &get_arena(){
+        return arena;
+    }
+
 private:
+    static constexpr uint32_t READ_SPINS = 64; // Loads of an odd epoch before read_begin yields
+    static constexpr uint32_t READ_YIELDS = 4; // Yields before read_begin sleeps
+
+    /**
+     * @brief Get the model this one was added to, through every parent, whose epoch and
+     * write_sem the tree of models shares
+     */
+    Model &get_root(void){
+        Model *root = this;
+        while(root->parent){
+            root = root->parent;
+        }
+        return *root;
+    }
+
+    const Model &get_root(void) const{
+        return const_cast<Model *>(this)->get_root();
+    }
+
     std::vector<BaseDataGeneric *> datas;
+    std::vector<Model *> models;
+    Helper::ObjectArena arena;
+    Model *parent;
+    std::atomic<uint32_t> epoch;
+    SemaphoreHandle_t write_sem;
+#if CONFIG_DATA_NO_HEAP
+    StaticSemaphore_t write_sem_buf;
+#endif
 };
 
 };
@@ -0,0 +1,129 @@
+// Internal includes
+#include "Data/Helper/Arena.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+#include "esp_log.h"
+
+// Standard library includes
+#include <cstdlib>
+
+#define TAG "Arena"
+
+using namespace Data::Helper;
+
+Arena::Arena(void *buf, size_t buf_sz) :
+        buf(static_cast<uint8_t *>(buf)), buf_sz(buf_sz), pos(0), classes(), large(nullptr), free_sz(0)
+{
+    sem_h = xSemaphoreCreateMutexStatic(&sem_buf);
+}
+
+Arena::~Arena() {
+    vSemaphoreDelete(sem_h);
+}
+
+void *Arena::allocate(size_t size, size_t align) {
+    size = block_size(size);
+    if (align <= BLOCK) {
+        // Every block is BLOCK aligned, over aligned requests only take fresh memory
+        void *block = take_free(size);
+        if (block) {
+            return block;
+        }
+        align = BLOCK;
+    }
+
+    size_t start = pos.load(std::memory_order_relaxed);
+    size_t aligned;
+    do {
+        aligned = (((uintptr_t)buf + start + align - 1) & ~(uintptr_t)(align - 1)) - (uintptr_t)buf;
+        if (aligned + size > buf_sz) {
+            return nullptr;
+        }
+    } while (!pos.compare_exchange_weak(start, aligned + size, std::memory_order_relaxed));
+    return &buf[aligned];
+}
+
+void *Arena::take_free(size_t size) {
+    FreeBlock *block = nullptr;
+    xSemaphoreTake(sem_h, portMAX_DELAY);
+    if (size <= MAX_CLASS_SIZE) {
+        FreeBlock *&head = classes[size / BLOCK - 1];
+        block = head;
+        if (block) {
+            head = block->next;
+        }
+    } else {
+        for (FreeBlock **link = &large; *link; link = &(*link)->next) {
+            if ((*link)->size == size) {
+                block = *link;
+                *link = block->next;
+                break;
+            }
+        }
+    }
+    if (block) {
+        free_sz -= size;
+    }
+    xSemaphoreGive(sem_h);
+    return block;
+}
+
+void Arena::deallocate(void *memory, size_t size) {
+    if (memory == nullptr) {
+        return;
+    }
+    size = block_size(size);
+    FreeBlock *block = static_cast<FreeBlock *>(memory);
+    block->size = size;
+    xSemaphoreTake(sem_h, portMAX_DELAY);
+    FreeBlock *&head = size <= MAX_CLASS_SIZE ? classes[size / BLOCK - 1] : large;
+    block->next = head;
+    head = block;
+    free_sz += size;
+    xSemaphoreGive(sem_h);
+}
+
+size_t Arena::get_used(void) const {
+    return pos.load(std::memory_order_relaxed);
+}
+
+size_t Arena::get_free(void) const {
+    return free_sz;
+}
+
+size_t Arena::get_capacity(void) const {
+    return buf_sz;
+}
+
+#if CONFIG_DATA_NO_HEAP
+
+static_assert(CONFIG_DATA_ARENA_SIZE > 0, "CONFIG_DATA_ARENA_SIZE must be set when building without a heap");
+
+alignas(max_align_t) static uint8_t s_arena_buf[CONFIG_DATA_ARENA_SIZE];
+alignas(Arena) static uint8_t s_arena_mem[sizeof(Arena)];
+
+Arena *Data::Helper::GetArena(void) {
+    // Made once whichever task gets here first, and never destroyed so objects freed
+    // by static destructors still find it
+    static Arena *arena = new (s_arena_mem) Arena(s_arena_buf, sizeof(s_arena_buf));
+    return arena;
+}
+
+void *Data::Helper::arena_allocate(size_t size, size_t align) {
+    void *memory = GetArena()->allocate(size, align);
+    if (memory == nullptr) {
+        ESP_LOGE(TAG, "Out of arena allocating %u bytes, %u of %u used and %u free for reuse, increase CONFIG_DATA_ARENA_SIZE",
+                (unsigned)size, (unsigned)GetArena()->get_used(), (unsigned)GetArena()->get_capacity(),
+                (unsigned)GetArena()->get_free());
+        abort();
+    }
+    return memory;
+}
+
+void Data::Helper::arena_free(void *memory, size_t size) {
+    GetArena()->deallocate(memory, size);
+}
+
+#endif
@@ -0,0 +1,277 @@
+// Internal includes
+#include "Data/Helper/ChangeStream.hpp"
+#include "Data/Helper/Arena.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+#include "esp_log.h"
+#include "esp_random.h"
+
+// Standard library includes
+
+#define TAG "ChangeStream"
+
+using namespace Data;
+using namespace Data::Helper;
+
+static size_t varint_size(size_t value) {
+    size_t size = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        size++;
+    }
+    return size;
+}
+
+static size_t varint_write(size_t value, uint8_t *buf) {
+    size_t i = 0;
+    while (value >= 0x80) {
+        buf[i++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    buf[i++] = (uint8_t)value;
+    return i;
+}
+
+static bool varint_read(const uint8_t *buf, size_t buf_sz, size_t &pos, size_t &value) {
+    value = 0;
+    for (size_t shift = 0; pos < buf_sz && shift < sizeof(size_t) * 8; shift += 7) {
+        uint8_t byte = buf[pos++];
+        value |= (size_t)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void u32_write(uint32_t value, uint8_t *buf) {
+    for (size_t i = 0; i < 4; i++) {
+        buf[i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+static uint32_t u32_read(const uint8_t *buf) {
+    uint32_t value = 0;
+    for (size_t i = 0; i < 4; i++) {
+        value |= (uint32_t)buf[i] << (8 * i);
+    }
+    return value;
+}
+
+/**
+ * @brief Step over a record, checking its key id and length varints and that its value fits
+ */
+static bool record_read(const uint8_t *frame, size_t frame_sz, size_t &pos, size_t &id, size_t &value_sz) {
+    return varint_read(frame, frame_sz, pos, id) && varint_read(frame, frame_sz, pos, value_sz) &&
+        value_sz <= frame_sz - pos;
+}
+
+ChangeStreamEncoder::ChangeStreamEncoder(BaseDataGeneric &root, write_cb_t write_cb, uint8_t *buf, size_t buf_sz, uint32_t flush_interval_ms) :
+        write_cb(write_cb), buf(buf), buf_sz(buf_sz), flush_interval_ms(flush_interval_ms),
+        last_flush_ms(0), session(esp_random()), sequence(0), data_count(0), dirty_count(0)
+{
+    if (buf_sz < ChangeStream::HEADER_SZ) {
+        ESP_LOGE(TAG, "Frame buffer of %u bytes can't hold a header, nothing will be replicated", (unsigned)buf_sz);
+    }
+    root.for_each([this](BaseDataGeneric &) {
+        data_count++;
+    });
+    datas = create_array<BaseDataGeneric *>(data_count);
+    sub_ids = create_array<size_t>(data_count);
+    dirty = create_array<bool>(data_count);
+    dirty_ids = create_array<size_t>(data_count);
+
+    size_t i = 0;
+    root.for_each([this, &i](BaseDataGeneric &data) {
+        datas[i++] = &data;
+    });
+    for (i = 0; i < data_count; i++) {
+        dirty[i] = false;
+        sub_ids[i] = datas[i]->sub_change([this, i](BaseDataGeneric &) {
+            mark(i);
+        });
+    }
+}
+
+ChangeStreamEncoder::~ChangeStreamEncoder() {
+    for (size_t i = 0; i < data_count; i++) {
+        datas[i]->unsub_change(sub_ids[i]);
+    }
+    destroy_array(datas, data_count);
+    destroy_array(sub_ids, data_count);
+    destroy_array(dirty, data_count);
+    destroy_array(dirty_ids, data_count);
+}
+
+void ChangeStreamEncoder::mark_all(void) {
+    for (size_t i = 0; i < data_count; i++) {
+        mark(i);
+    }
+}
+
+bool ChangeStreamEncoder::poll(uint32_t now_ms) {
+    if (dirty_count == 0 || (uint32_t)(now_ms - last_flush_ms) < flush_interval_ms) {
+        return false;
+    }
+    last_flush_ms = now_ms;
+    flush();
+    return true;
+}
+
+void ChangeStreamEncoder::flush(void) {
+    if (buf_sz < ChangeStream::HEADER_SZ) {
+        for (size_t i = 0; i < dirty_count; i++) {
+            dirty[dirty_ids[i]] = false;
+        }
+        dirty_count = 0;
+        return;
+    }
+
+    size_t pos = ChangeStream::HEADER_SZ;
+    uint16_t count = 0;
+
+    for (size_t i = 0; i < dirty_count; i++) {
+        size_t id = dirty_ids[i];
+        dirty[id] = false;
+        BaseDataGeneric *data = datas[id];
+        if (!data->is_encodable()) {
+            continue;
+        }
+
+        size_t value_sz = data->encoded_size();
+        size_t record_sz = varint_size(id) + varint_size(value_sz) + value_sz;
+        if (record_sz > buf_sz - ChangeStream::HEADER_SZ) {
+            ESP_LOGE(TAG, "%s is too large to replicate: %u bytes", data->get_name() ? data->get_name() : "?", (unsigned)value_sz);
+            continue;
+        }
+        if (pos + record_sz > buf_sz || count == UINT16_MAX) {
+            write_frame(pos, count);
+            pos = ChangeStream::HEADER_SZ;
+            count = 0;
+        }
+
+        pos += varint_write(id, &buf[pos]);
+        pos += varint_write(value_sz, &buf[pos]);
+        pos += data->encode(&buf[pos], buf_sz - pos);
+        count++;
+    }
+    dirty_count = 0;
+
+    if (count > 0) {
+        write_frame(pos, count);
+    }
+}
+
+uint32_t ChangeStreamEncoder::get_sequence(void) const {
+    return sequence;
+}
+
+uint32_t ChangeStreamEncoder::get_session(void) const {
+    return session;
+}
+
+void ChangeStreamEncoder::mark(size_t key_id) {
+    if (!dirty[key_id]) {
+        dirty[key_id] = true;
+        dirty_ids[dirty_count++] = key_id;
+    }
+}
+
+void ChangeStreamEncoder::write_frame(size_t frame_sz, uint16_t count) {
+    buf[0] = ChangeStream::FRAME_MAGIC;
+    u32_write(session, &buf[1]);
+    u32_write(sequence, &buf[5]);
+    buf[9] = (uint8_t)count;
+    buf[10] = (uint8_t)(count >> 8);
+    sequence++;
+    write_cb(buf, frame_sz);
+}
+
+ChangeStreamDecoder::ChangeStreamDecoder(BaseDataGeneric &root) :
+        data_count(0), synced(false), session(0), sequence(0), gaps(0), resyncs(0)
+{
+    root.for_each([this](BaseDataGeneric &) {
+        data_count++;
+    });
+    datas = create_array<BaseDataGeneric *>(data_count);
+
+    size_t i = 0;
+    root.for_each([this, &i](BaseDataGeneric &data) {
+        datas[i++] = &data;
+    });
+}
+
+ChangeStreamDecoder::~ChangeStreamDecoder() {
+    destroy_array(datas, data_count);
+}
+
+bool ChangeStreamDecoder::apply(const uint8_t *frame, size_t frame_sz) {
+    if (frame_sz < ChangeStream::HEADER_SZ || frame[0] != ChangeStream::FRAME_MAGIC) {
+        ESP_LOGE(TAG, "Malformed frame header");
+        return false;
+    }
+
+    uint32_t frame_session = u32_read(&frame[1]);
+    uint32_t frame_sequence = u32_read(&frame[5]);
+    uint16_t count = (uint16_t)(frame[9] | (frame[10] << 8));
+
+    size_t pos = ChangeStream::HEADER_SZ;
+    for (uint16_t i = 0; i < count; i++) {
+        size_t id = 0;
+        size_t value_sz = 0;
+        if (!record_read(frame, frame_sz, pos, id, value_sz)) {
+            ESP_LOGE(TAG, "Malformed record %u in frame %u", (unsigned)i, (unsigned)frame_sequence);
+            return false;
+        }
+        pos += value_sz;
+    }
+    if (pos != frame_sz) {
+        ESP_LOGE(TAG, "Frame %u has %u bytes past its records", (unsigned)frame_sequence, (unsigned)(frame_sz - pos));
+        return false;
+    }
+
+    if (synced && frame_session != session) {
+        ESP_LOGI(TAG, "New session %08x, resyncing at frame %u", (unsigned)frame_session, (unsigned)frame_sequence);
+        resyncs++;
+    } else if (synced) {
+        int32_t diff = (int32_t)(frame_sequence - sequence);
+        if (diff < 0) {
+            ESP_LOGW(TAG, "Stale frame %u, expected %u", (unsigned)frame_sequence, (unsigned)sequence);
+            return false;
+        }
+        gaps += diff;
+    }
+    synced = true;
+    session = frame_session;
+    sequence = frame_sequence + 1;
+
+    pos = ChangeStream::HEADER_SZ;
+    for (uint16_t i = 0; i < count; i++) {
+        size_t id = 0;
+        size_t value_sz = 0;
+        record_read(frame, frame_sz, pos, id, value_sz);
+        if (id < data_count) {
+            if (!datas[id]->decode(&frame[pos], value_sz)) {
+                ESP_LOGW(TAG, "Could not decode key %u", (unsigned)id);
+            }
+        } else {
+            ESP_LOGW(TAG, "Unknown key %u", (unsigned)id);
+        }
+        pos += value_sz;
+    }
+    return true;
+}
+
+uint32_t ChangeStreamDecoder::get_sequence(void) const {
+    return sequence;
+}
+
+uint32_t ChangeStreamDecoder::get_gaps(void) const {
+    return gaps;
+}
+
+uint32_t ChangeStreamDecoder::get_resyncs(void) const {
+    return resyncs;
+}
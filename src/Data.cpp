@@ -4,18 +4,93 @@
 // bwl component includes
 
 // Esp-idf component includes
+#include "FreeRTOS/FreeRTOS.h"
+#include "FreeRTOS/semphr.h"
 
 // Standard library includes
+#include <cstring>
 
 using namespace Data;
 
-static Helper::NvsHandler *s_nvs_handle = nullptr;
+namespace {
+    struct NvsEntry {
+        const char *nvs_namespace;
+        const char *partition;
+        Helper::NvsHandler *handler;
+        NvsEntry *next;
+    };
+
+    NvsEntry *s_nvs_handlers = nullptr;
+
+    /**
+     * @brief Lock guarding s_nvs_handlers, entries are only ever added
+     */
+    SemaphoreHandle_t nvs_handlers_lock(void) {
+#if CONFIG_DATA_NO_HEAP
+        static StaticSemaphore_t sem_buf;
+        static SemaphoreHandle_t sem_h = xSemaphoreCreateMutexStatic(&sem_buf);
+#else
+        static SemaphoreHandle_t sem_h = xSemaphoreCreateMutex();
+#endif
+        return sem_h;
+    }
+
+    /**
+     * @brief Get the newest entry, the ones after it can be walked without the lock
+     */
+    NvsEntry *nvs_handlers(void) {
+        xSemaphoreTake(nvs_handlers_lock(), portMAX_DELAY);
+        NvsEntry *entry = s_nvs_handlers;
+        xSemaphoreGive(nvs_handlers_lock());
+        return entry;
+    }
+
+    bool same_name(const char *a, const char *b) {
+        return a == b || (a && b && std::strcmp(a, b) == 0);
+    }
+};
 
 Helper::NvsHandler *Factory::GetNvsHandler(void) {
-    if (s_nvs_handle == nullptr) {
-        s_nvs_handle = new Helper::NvsHandler("storage");
+    return GetNvsHandler("storage");
+}
+
+Helper::NvsHandler *Factory::GetNvsHandler(const char *nvs_namespace, const char *partition) {
+    // Held while making the handler so two tasks asking for it at once get the same one
+    xSemaphoreTake(nvs_handlers_lock(), portMAX_DELAY);
+    for (NvsEntry *entry = s_nvs_handlers; entry; entry = entry->next) {
+        if (same_name(entry->nvs_namespace, nvs_namespace) && same_name(entry->partition, partition)) {
+            xSemaphoreGive(nvs_handlers_lock());
+            return entry->handler;
+        }
+    }
+
+    Helper::NvsHandler *handler = Helper::create<Helper::NvsHandler>(nvs_namespace,
+            Helper::create<Helper::NvsFlashBackend>(nvs_namespace, partition), true);
+#ifdef CONFIG_DATA_JOURNAL_PARTITION
+    // Only the default handler is journaled, a journal can't be shared
+    if (CONFIG_DATA_JOURNAL_PARTITION[0] != '\0' && partition == nullptr && std::strcmp(nvs_namespace, "storage") == 0) {
+        handler->set_journal(Helper::create<Helper::Journal>(CONFIG_DATA_JOURNAL_PARTITION));
     }
-    return s_nvs_handle;
+#endif
+    s_nvs_handlers = Helper::create<NvsEntry>(NvsEntry{nvs_namespace, partition, handler, s_nvs_handlers});
+    xSemaphoreGive(nvs_handlers_lock());
+    return handler;
+}
+
+void Factory::ForEachNvsHandler(const Helper::Callback<void(Helper::NvsHandler &)> &fn) {
+    for (NvsEntry *entry = nvs_handlers(); entry; entry = entry->next) {
+        fn(*entry->handler);
+    }
+}
+
+Helper::IsrDispatcher *Factory::GetIsrDispatcher(void) {
+    static Helper::IsrDispatcher *isr_dispatcher = Helper::create<Helper::IsrDispatcher>();
+    return isr_dispatcher;
+}
+
+Helper::ObjectArena &Factory::GetObjectArena(void) {
+    static Helper::ObjectArena *object_arena = Helper::create<Helper::ObjectArena>();
+    return *object_arena;
 }
 
 const char *Factory::get_name(const char *nvs_key, const char *name) {
@@ -24,3 +99,20 @@ const char *Factory::get_name(const char *nvs_key, const char *name) {
     return name;
 }
 
+
+Factory::Usage Factory::GetUsage(void) {
+    Usage usage = {};
+#if CONFIG_DATA_NO_HEAP
+    usage.arena_used = Helper::GetArena()->get_used();
+    usage.arena_capacity = Helper::GetArena()->get_capacity();
+    usage.sub_capacity = CONFIG_DATA_SUB_CAPACITY;
+#endif
+    for (NvsEntry *entry = nvs_handlers(); entry; entry = entry->next) {
+        if (entry->handler->get_dirty_high_water() > usage.dirty_high_water) {
+            usage.dirty_high_water = entry->handler->get_dirty_high_water();
+        }
+        usage.dirty_capacity = entry->handler->get_dirty_capacity();
+    }
+    usage.sub_high_water = Helper::sub_high_water();
+    return usage;
+}
@@ -0,0 +1,148 @@
+// Internal includes
+#include "Descriptor.hpp"
+#include "Model.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+#include "esp_log.h"
+
+// Standard library includes
+#include <cstring>
+
+#define TAG "Descriptor"
+
+using namespace Data;
+using namespace Data::Helper;
+
+template <typename T>
+static T read_as(const void *value) {
+    T out;
+    std::memcpy(&out, value, sizeof(T));
+    return out;
+}
+
+static void write_described(Writer &writer, const Model &model, const Descriptor &descriptor) {
+    const void *value = descriptor.value(model);
+    switch (descriptor.type) {
+        case TypeId::BOOL:   writer.put_bool(read_as<bool>(value)); break;
+        case TypeId::INT8:   writer.put_int(read_as<int8_t>(value)); break;
+        case TypeId::INT16:  writer.put_int(read_as<int16_t>(value)); break;
+        case TypeId::INT32:  writer.put_int(read_as<int32_t>(value)); break;
+        case TypeId::INT64:  writer.put_int(read_as<int64_t>(value)); break;
+        case TypeId::UINT8:  writer.put_uint(read_as<uint8_t>(value)); break;
+        case TypeId::UINT16: writer.put_uint(read_as<uint16_t>(value)); break;
+        case TypeId::UINT32: writer.put_uint(read_as<uint32_t>(value)); break;
+        case TypeId::UINT64: writer.put_uint(read_as<uint64_t>(value)); break;
+        case TypeId::FLOAT:  writer.put_float(read_as<float>(value)); break;
+        case TypeId::DOUBLE: writer.put_float(read_as<double>(value)); break;
+        case TypeId::STRING: {
+            const std::string &str = *static_cast<const std::string *>(value);
+            if (writer.get_mode() == Writer::Mode::JSON) {
+                writer.put_string(str.data(), str.size());
+            } else {
+                writer.put(str.data(), str.size());
+            }
+            break;
+        }
+        case TypeId::BLOB:   writer.put_hex(value, descriptor.size); break;
+        default:
+            // Only the object knows how to format its value
+            descriptor.object(const_cast<Model &>(model)).format_value(writer);
+            break;
+    }
+}
+
+bool Helper::check_descriptors(const Model &model, Span<const Descriptor> table) {
+    bool ok = true;
+    for (const Descriptor &descriptor : table) {
+        uint8_t mismatch = descriptor.check(model, descriptor);
+        if (mismatch & Descriptor::NVS_KEY_MISMATCH) {
+            ESP_LOGE(TAG, "%s.%s: nvs key doesn't match the object's", model.get_name() ? model.get_name() : "?", descriptor.name);
+        }
+        if (mismatch & Descriptor::DEFAULT_MISMATCH) {
+            ESP_LOGE(TAG, "%s.%s: default doesn't match the object's", model.get_name() ? model.get_name() : "?", descriptor.name);
+        }
+        if (mismatch & Descriptor::BOUNDS_MISMATCH) {
+            ESP_LOGE(TAG, "%s.%s: bounds don't match the object's", model.get_name() ? model.get_name() : "?", descriptor.name);
+        }
+        ok = ok && mismatch == 0;
+    }
+    return ok;
+}
+
+const Descriptor *Helper::find_descriptor(Span<const Descriptor> table, const char *name) {
+    for (const Descriptor &descriptor : table) {
+        if (std::strcmp(descriptor.name, name) == 0) {
+            return &descriptor;
+        }
+    }
+    return nullptr;
+}
+
+void Helper::export_described(const Model &model, Span<const Descriptor> table, Writer &writer, uint32_t depth) {
+    const char *name = model.get_name();
+    if (writer.get_mode() == Writer::Mode::JSON) {
+        if (depth > 0) {
+            writer.put_string(name ? name : "");
+            writer.put(':');
+        }
+        writer.put('{');
+        for (size_t i = 0; i < table.size() && !writer.is_full(); i++) {
+            if (i > 0) writer.put(',');
+            writer.put_string(table[i].name);
+            writer.put(':');
+            write_described(writer, model, table[i]);
+        }
+        writer.put('}');
+    } else {
+        writer.put_indent(depth);
+        writer.put(name ? name : "");
+        writer.put('\n');
+        for (size_t i = 0; i < table.size() && !writer.is_full(); i++) {
+            writer.put_indent(depth + 1);
+            writer.put(table[i].name);
+            writer.put(": ");
+            write_described(writer, model, table[i]);
+            writer.put('\n');
+        }
+    }
+}
+
+size_t Helper::described_size(Span<const Descriptor> table) {
+    size_t size = 0;
+    for (const Descriptor &descriptor : table) {
+        size += descriptor.size;
+    }
+    return size;
+}
+
+size_t Helper::encode_described(const Model &model, Span<const Descriptor> table, uint8_t *buf, size_t buf_sz) {
+    size_t size = described_size(table);
+    if (size > buf_sz) {
+        return 0;
+    }
+    size_t offset = 0;
+    for (const Descriptor &descriptor : table) {
+        if (descriptor.size == 0) continue;
+        std::memcpy(buf + offset, descriptor.value(model), descriptor.size);
+        offset += descriptor.size;
+    }
+    return size;
+}
+
+bool Helper::decode_described(Model &model, Span<const Descriptor> table, const uint8_t *buf, size_t buf_sz) {
+    if (buf_sz != described_size(table)) {
+        return false;
+    }
+    size_t offset = 0;
+    for (const Descriptor &descriptor : table) {
+        if (descriptor.size == 0) continue;
+        BaseDataGeneric &object = descriptor.object(model);
+        if (object.set_encoded(buf + offset, descriptor.size)) {
+            object.store();
+        }
+        offset += descriptor.size;
+    }
+    return true;
+}
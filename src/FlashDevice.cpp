@@ -0,0 +1,37 @@
+// Internal includes
+#include "Data/Helper/FlashDevice.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+
+// Standard library includes
+
+using namespace Data::Helper;
+
+PartitionDevice::PartitionDevice(const char *label) :
+        partition(label ? esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label) : nullptr) { }
+
+bool PartitionDevice::is_open(void) const {
+    return partition != nullptr;
+}
+
+esp_err_t PartitionDevice::read(size_t offset, void *data, size_t data_sz) {
+    return esp_partition_read(partition, offset, data, data_sz);
+}
+
+esp_err_t PartitionDevice::write(size_t offset, const void *data, size_t data_sz) {
+    return esp_partition_write(partition, offset, data, data_sz);
+}
+
+esp_err_t PartitionDevice::erase(size_t offset, size_t size) {
+    return esp_partition_erase_range(partition, offset, size);
+}
+
+size_t PartitionDevice::get_size(void) const {
+    return partition ? partition->size : 0;
+}
+
+size_t PartitionDevice::get_sector_size(void) const {
+    return partition ? partition->erase_size : 0;
+}
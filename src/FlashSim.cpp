@@ -0,0 +1,140 @@
+// Internal includes
+#include "Data/Helper/FlashSim.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+
+// Standard library includes
+#include <cstdint>
+#include <cstring>
+
+using namespace Data::Helper;
+
+FlashSim::Config FlashSim::default_config(void) {
+    Config config;
+    config.size = 16 * 4096;
+    config.page_sz = 256;
+    config.sector_sz = 4096;
+    config.read_ns_per_byte = 25;
+    config.program_us = 700;
+    config.erase_us = 45000;
+    config.endurance = 100000;
+    return config;
+}
+
+FlashSim::FlashSim(const Config &config) :
+        config(config), mem(config.size, 0xff), sector_erases(config.size / config.sector_sz, 0),
+        stats(), power_budget(SIZE_MAX) { }
+
+esp_err_t FlashSim::read(size_t offset, void *data, size_t data_sz) {
+    if (offset + data_sz > mem.size()) {
+        return ESP_FAIL;
+    }
+    std::memcpy(data, &mem[offset], data_sz);
+    stats.bytes_read += data_sz;
+    spend((uint64_t)data_sz * config.read_ns_per_byte / 1000);
+    return ESP_OK;
+}
+
+esp_err_t FlashSim::write(size_t offset, const void *data, size_t data_sz) {
+    if (offset + data_sz > mem.size()) {
+        return ESP_FAIL;
+    }
+    if (data_sz == 0) {
+        return ESP_OK;
+    }
+
+    size_t n = data_sz < power_budget ? data_sz : power_budget;
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    for (size_t i = 0; i < n; i++) {
+        if ((bytes[i] & ~mem[offset + i]) != 0) {
+            stats.program_violations++;
+        }
+        mem[offset + i] &= bytes[i];
+    }
+    if (power_budget != SIZE_MAX) {
+        power_budget -= n;
+    }
+
+    size_t pages = (offset + n - 1) / config.page_sz - offset / config.page_sz + 1;
+    stats.bytes_programmed += n;
+    stats.program_ops += pages;
+    spend((uint64_t)pages * config.program_us);
+    return n == data_sz ? ESP_OK : ESP_FAIL;
+}
+
+esp_err_t FlashSim::erase(size_t offset, size_t size) {
+    if (offset % config.sector_sz != 0 || size % config.sector_sz != 0 || offset + size > mem.size()) {
+        return ESP_FAIL;
+    }
+    if (power_budget == 0) {
+        return ESP_FAIL;
+    }
+
+    uint64_t us = 0;
+    for (size_t sector = offset / config.sector_sz; sector < (offset + size) / config.sector_sz; sector++) {
+        std::memset(&mem[sector * config.sector_sz], 0xff, config.sector_sz);
+        sector_erases[sector]++;
+        if (sector_erases[sector] > stats.max_sector_erases) {
+            stats.max_sector_erases = sector_erases[sector];
+        }
+        stats.erases++;
+        us += config.erase_us;
+    }
+    spend(us);
+    return ESP_OK;
+}
+
+size_t FlashSim::get_size(void) const {
+    return config.size;
+}
+
+size_t FlashSim::get_sector_size(void) const {
+    return config.sector_sz;
+}
+
+void FlashSim::cut_power_after(size_t bytes) {
+    power_budget = bytes;
+}
+
+void FlashSim::restore_power(void) {
+    power_budget = SIZE_MAX;
+}
+
+const FlashSim::Config &FlashSim::get_config(void) const {
+    return config;
+}
+
+const FlashSim::Stats &FlashSim::get_stats(void) const {
+    return stats;
+}
+
+uint32_t FlashSim::get_sector_erases(size_t sector) const {
+    return sector < sector_erases.size() ? sector_erases[sector] : 0;
+}
+
+uint64_t FlashSim::get_time_us(void) const {
+    return stats.time_us;
+}
+
+double FlashSim::get_projected_lifetime(double elapsed_s) const {
+    if (stats.max_sector_erases == 0) {
+        return -1; // No wear seen, the lifetime can't be projected
+    }
+    return elapsed_s * config.endurance / stats.max_sector_erases;
+}
+
+void FlashSim::reset_stats(void) {
+    stats = Stats();
+    for (auto &erases : sector_erases) {
+        erases = 0;
+    }
+}
+
+void FlashSim::spend(uint64_t us) {
+    stats.time_us += us;
+    if (us > stats.worst_op_us) {
+        stats.worst_op_us = us;
+    }
+}
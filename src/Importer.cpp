@@ -0,0 +1,487 @@
+// Internal includes
+#include "Importer.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+
+// Standard library includes
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+using namespace Data;
+
+static bool is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+static int base_of(const char *str) {
+    return str[0] == '0' && (str[1] == 'x' || str[1] == 'X') ? 16 : 10;
+}
+
+static bool parse_int(const char *str, int64_t &out) {
+    char *end;
+    errno = 0;
+    out = std::strtoll(str, &end, base_of(str));
+    return end != str && *end == '\0' && errno == 0;
+}
+
+static bool parse_uint(const char *str, uint64_t &out) {
+    char *end;
+    errno = 0;
+    out = std::strtoull(str, &end, base_of(str));
+    return end != str && *end == '\0' && errno == 0 && str[0] != '-';
+}
+
+static bool parse_double(const char *str, double &out) {
+    char *end;
+    out = std::strtod(str, &end);
+    return end != str && *end == '\0';
+}
+
+template <typename T>
+static size_t put_int(uint8_t *bytes, int64_t value) {
+    if (value < std::numeric_limits<T>::min() || value > std::numeric_limits<T>::max()) return 0;
+    T out = (T)value;
+    std::memcpy(bytes, &out, sizeof(T));
+    return sizeof(T);
+}
+
+template <typename T>
+static size_t put_uint(uint8_t *bytes, uint64_t value) {
+    if (value > std::numeric_limits<T>::max()) return 0;
+    T out = (T)value;
+    std::memcpy(bytes, &out, sizeof(T));
+    return sizeof(T);
+}
+
+static int hex_digit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+/**
+ * @brief Decode "0x0011.." in place
+ *
+ * @return size_t Number of bytes, 0 if str isn't hex
+ */
+static size_t parse_hex(char *str, size_t str_sz) {
+    if (str_sz < 4 || str_sz % 2 || base_of(str) != 16) return 0;
+    uint8_t *bytes = reinterpret_cast<uint8_t *>(str);
+    for (size_t i = 2; i < str_sz; i += 2) {
+        int high = hex_digit(str[i]);
+        int low = hex_digit(str[i + 1]);
+        if (high < 0 || low < 0) return 0;
+        bytes[i / 2 - 1] = (uint8_t)(high << 4 | low);
+    }
+    return str_sz / 2 - 1;
+}
+
+static char unescape(char c) {
+    switch (c) {
+        case 'n': return '\n';
+        case 't': return '\t';
+        case 'r': return '\r';
+        case 'b': return '\b';
+        case 'f': return '\f';
+        case '"':
+        case '\\':
+        case '/': return c;
+        default: return '\0'; // \u isn't supported
+    }
+}
+
+Importer::Importer(Model &root) :
+        root(root), state(State::START), finished(false), overflow(false), key(), key_sz(0),
+        value(), value_sz(0), depth(0), bases(), line(1), set_count(0), skipped_count(0),
+        error(Error::NONE), error_line(0), touched(), touched_count(0), handlers(), handler_count(0)
+{ }
+
+Importer::~Importer() {
+    finish();
+}
+
+bool Importer::feed(const char *data, size_t data_sz) {
+    for (size_t i = 0; i < data_sz && state != State::FAILED; i++) {
+        if (!step(data[i])) {
+            state = State::FAILED;
+            error = Error::SYNTAX;
+            error_line = line;
+        }
+        if (data[i] == '\n') line++;
+    }
+    return state != State::FAILED;
+}
+
+bool Importer::finish(void) {
+    if (finished) {
+        return state == State::DONE;
+    }
+    finished = true;
+    switch (state) {
+        case State::KV_VALUE:
+            end_kv_line();
+            state = State::DONE;
+            break;
+        case State::START:
+        case State::KV_LINE:
+        case State::KV_COMMENT:
+            state = State::DONE;
+            break;
+        case State::DONE:
+        case State::FAILED:
+            break;
+        default:
+            state = State::FAILED;
+            error = Error::SYNTAX;
+            error_line = line;
+            break;
+    }
+
+    // Subscribers see every value set at once, then it is all written in one commit
+    for (size_t i = 0; i < touched_count; i++) {
+        if (touched[i].muted) {
+            touched[i].object->unmute_sub();
+        }
+    }
+    for (size_t i = 0; i < touched_count; i++) {
+        if (touched[i].changed) {
+            touched[i].object->store();
+        }
+    }
+    for (size_t i = 0; i < handler_count; i++) {
+        handlers[i]->commit();
+    }
+    return state == State::DONE;
+}
+
+size_t Importer::get_set_count(void) const {
+    return set_count;
+}
+
+size_t Importer::get_skipped_count(void) const {
+    return skipped_count;
+}
+
+Importer::Error Importer::get_error(void) const {
+    return error;
+}
+
+uint32_t Importer::get_error_line(void) const {
+    return error_line;
+}
+
+bool Importer::step(char c) {
+    switch (state) {
+        case State::START:
+            if (is_space(c)) return true;
+            if (c == '{') {
+                depth = 1;
+                bases[0] = 0;
+                state = State::JSON_KEY_START;
+                return true;
+            }
+            state = State::KV_LINE;
+            return step(c);
+
+        case State::KV_LINE:
+            if (is_space(c)) return true;
+            if (c == '#' || c == ';') {
+                state = State::KV_COMMENT;
+                return true;
+            }
+            key_sz = 0;
+            overflow = false;
+            state = State::KV_KEY;
+            return step(c);
+        case State::KV_COMMENT:
+            if (c == '\n') state = State::KV_LINE;
+            return true;
+        case State::KV_KEY:
+            if (c == '=') {
+                while (key_sz > 0 && is_space(key[key_sz - 1])) key_sz--;
+                value_sz = 0;
+                state = State::KV_VALUE;
+                return true;
+            }
+            if (c == '\n') return false;
+            push_key(c);
+            return true;
+        case State::KV_VALUE:
+            if (c == '\n') {
+                end_kv_line();
+                state = State::KV_LINE;
+            } else if (value_sz > 0 || (c != ' ' && c != '\t')) {
+                push_value(c);
+            }
+            return true;
+
+        case State::JSON_KEY_START:
+            if (is_space(c)) return true;
+            if (c == '}') break;
+            if (c != '"') return false;
+            if (bases[depth - 1] == SIZE_MAX) {
+                // The object's own key didn't fit
+                key_sz = 0;
+                overflow = true;
+            } else {
+                key_sz = bases[depth - 1];
+                overflow = false;
+                if (key_sz > 0) push_key('.');
+            }
+            state = State::JSON_KEY;
+            return true;
+        case State::JSON_KEY:
+            if (c == '"') state = State::JSON_COLON;
+            else if (c == '\\') state = State::JSON_KEY_ESCAPE;
+            else push_key(c);
+            return true;
+        case State::JSON_KEY_ESCAPE:
+            if (unescape(c) == '\0') return false;
+            push_key(unescape(c));
+            state = State::JSON_KEY;
+            return true;
+        case State::JSON_COLON:
+            if (is_space(c)) return true;
+            if (c != ':') return false;
+            value_sz = 0;
+            state = State::JSON_VALUE;
+            return true;
+        case State::JSON_VALUE:
+            if (is_space(c)) return true;
+            if (c == '{') {
+                if (depth == MAX_DEPTH) return false;
+                bases[depth++] = overflow ? SIZE_MAX : key_sz;
+                state = State::JSON_KEY_START;
+            } else if (c == '"') {
+                state = State::JSON_STRING;
+            } else if (c == '[') {
+                return false;
+            } else {
+                push_value(c);
+                state = State::JSON_SCALAR;
+            }
+            return true;
+        case State::JSON_STRING:
+            if (c == '"') {
+                apply();
+                state = State::JSON_NEXT;
+            } else if (c == '\\') {
+                state = State::JSON_STRING_ESCAPE;
+            } else {
+                push_value(c);
+            }
+            return true;
+        case State::JSON_STRING_ESCAPE:
+            if (unescape(c) == '\0') return false;
+            push_value(unescape(c));
+            state = State::JSON_STRING;
+            return true;
+        case State::JSON_SCALAR:
+            if (!is_space(c) && c != ',' && c != '}') {
+                push_value(c);
+                return true;
+            }
+            apply();
+            state = State::JSON_NEXT;
+            return step(c);
+        case State::JSON_NEXT:
+            if (is_space(c)) return true;
+            if (c == ',') {
+                state = State::JSON_KEY_START;
+                return true;
+            }
+            if (c == '}') break;
+            return false;
+
+        case State::DONE:
+            return is_space(c);
+        default:
+            return false;
+    }
+
+    // '}' closed an object
+    depth--;
+    state = depth == 0 ? State::DONE : State::JSON_NEXT;
+    return true;
+}
+
+void Importer::end_kv_line(void) {
+    while (value_sz > 0 && is_space(value[value_sz - 1])) value_sz--;
+    if (value_sz >= 2 && value[0] == '"' && value[value_sz - 1] == '"') {
+        std::memmove(value, value + 1, value_sz - 2);
+        value_sz -= 2;
+    }
+    apply();
+}
+
+void Importer::push_key(char c) {
+    if (key_sz + 1 < sizeof(key)) key[key_sz++] = c;
+    else overflow = true;
+}
+
+void Importer::push_value(char c) {
+    if (value_sz + 1 < sizeof(value)) value[value_sz++] = c;
+    else overflow = true;
+}
+
+void Importer::apply(void) {
+    if (overflow) {
+        skip(Error::TOO_LONG);
+        return;
+    }
+    key[key_sz] = '\0';
+    value[value_sz] = '\0';
+
+    // Walk the child models named by the key up to the object's own name
+    Model *model = &root;
+    const char *name = key;
+    const char *dot;
+    while ((dot = std::strchr(name, '.')) != nullptr) {
+        model = model->find_model(name, dot - name);
+        if (model == nullptr) {
+            skip(Error::UNKNOWN_KEY);
+            return;
+        }
+        name = dot + 1;
+    }
+    const Descriptor *descriptor = Helper::find_descriptor(model->get_descriptors(), name);
+    if (descriptor == nullptr) {
+        skip(Error::UNKNOWN_KEY);
+        return;
+    }
+
+    uint8_t bytes[8];
+    const uint8_t *data = bytes;
+    size_t data_sz = 0;
+    double number = 0;
+    int64_t i;
+    uint64_t u;
+    switch (descriptor->type) {
+        case TypeId::BOOL:
+            if (std::strcmp(value, "true") == 0 || std::strcmp(value, "1") == 0) bytes[0] = 1;
+            else if (std::strcmp(value, "false") == 0 || std::strcmp(value, "0") == 0) bytes[0] = 0;
+            else break;
+            number = bytes[0];
+            data_sz = sizeof(bool);
+            break;
+        case TypeId::INT8:   if (parse_int(value, i)) { number = i; data_sz = put_int<int8_t>(bytes, i); } break;
+        case TypeId::INT16:  if (parse_int(value, i)) { number = i; data_sz = put_int<int16_t>(bytes, i); } break;
+        case TypeId::INT32:  if (parse_int(value, i)) { number = i; data_sz = put_int<int32_t>(bytes, i); } break;
+        case TypeId::INT64:  if (parse_int(value, i)) { number = i; data_sz = put_int<int64_t>(bytes, i); } break;
+        case TypeId::UINT8:  if (parse_uint(value, u)) { number = u; data_sz = put_uint<uint8_t>(bytes, u); } break;
+        case TypeId::UINT16: if (parse_uint(value, u)) { number = u; data_sz = put_uint<uint16_t>(bytes, u); } break;
+        case TypeId::UINT32: if (parse_uint(value, u)) { number = u; data_sz = put_uint<uint32_t>(bytes, u); } break;
+        case TypeId::UINT64: if (parse_uint(value, u)) { number = u; data_sz = put_uint<uint64_t>(bytes, u); } break;
+        case TypeId::FLOAT:
+            if (parse_double(value, number)) {
+                float f = (float)number;
+                std::memcpy(bytes, &f, sizeof(f));
+                data_sz = sizeof(f);
+            }
+            break;
+        case TypeId::DOUBLE:
+            if (parse_double(value, number)) {
+                std::memcpy(bytes, &number, sizeof(number));
+                data_sz = sizeof(number);
+            }
+            break;
+        case TypeId::STRING:
+            data = reinterpret_cast<const uint8_t *>(value);
+            data_sz = value_sz;
+            break;
+        case TypeId::BLOB:
+            data = reinterpret_cast<const uint8_t *>(value);
+            data_sz = parse_hex(value, value_sz);
+            if (data_sz != descriptor->size) data_sz = 0;
+            break;
+        default:
+            break;
+    }
+    if (data_sz == 0 && descriptor->type != TypeId::STRING) {
+        skip(Error::BAD_VALUE);
+        return;
+    }
+    if (descriptor->bounded && !(number >= descriptor->min && number < descriptor->max)) {
+        skip(Error::OUT_OF_BOUNDS);
+        return;
+    }
+
+    BaseDataGeneric &object = descriptor->object(*model);
+    if (!touch(object)) {
+        skip(Error::TOO_MANY_HANDLERS);
+        return;
+    }
+    if (object.set_encoded(data, data_sz)) {
+        Touched *entry = find_touched(object);
+        if (entry) {
+            entry->changed = true;
+        } else {
+            object.store();
+        }
+    } else if (!is_unchanged(object, data, data_sz)) {
+        // SetDelegates like SetDifferent also reject the value the object already holds
+        skip(Error::REJECTED);
+        return;
+    }
+    set_count++;
+}
+
+void Importer::skip(Error error) {
+    skipped_count++;
+    if (this->error == Error::NONE) {
+        this->error = error;
+        error_line = line;
+    }
+}
+
+/**
+ * @brief Track the object's nvs handler for finish to commit, then mute the object until
+ * finish if there is room to track it
+ *
+ * @retval False if the handler can't be tracked, the object must not be set
+ */
+bool Importer::touch(BaseDataGeneric &object) {
+    Helper::NvsHandler *handler = object.get_nvs_handler();
+    if (handler) {
+        bool found = false;
+        for (size_t i = 0; i < handler_count && !found; i++) {
+            found = handlers[i] == handler;
+        }
+        if (!found) {
+            if (handler_count == MAX_HANDLERS) {
+                return false;
+            }
+            handlers[handler_count++] = handler;
+        }
+    }
+
+    if (find_touched(object) == nullptr && touched_count < CONFIG_DATA_IMPORT_MAX_OBJECTS) {
+        bool muted = !object.is_muted();
+        if (muted) {
+            object.mute_sub();
+        }
+        touched[touched_count++] = Touched{&object, muted, false};
+    }
+    return true;
+}
+
+Importer::Touched *Importer::find_touched(const BaseDataGeneric &object) {
+    for (size_t i = 0; i < touched_count; i++) {
+        if (touched[i].object == &object) return &touched[i];
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Whether or not the object already holds the value encoded in data
+ */
+bool Importer::is_unchanged(const BaseDataGeneric &object, const uint8_t *data, size_t data_sz) const {
+    uint8_t current[CONFIG_DATA_IMPORT_VALUE_SIZE];
+    return object.encoded_size() == data_sz && data_sz <= sizeof(current) &&
+        object.encode(current, sizeof(current)) == data_sz && std::memcmp(current, data, data_sz) == 0;
+}
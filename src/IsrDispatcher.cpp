@@ -0,0 +1,56 @@
+// Internal includes
+#include "Data/Isr/IsrDispatcher.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+
+// Standard library includes
+
+using namespace Data::Helper;
+
+IsrDispatcher::IsrDispatcher(void) :
+        pending(nullptr)
+{
+#if CONFIG_DATA_NO_HEAP
+    sem_h = xSemaphoreCreateBinaryStatic(&sem_buf);
+#else
+    sem_h = xSemaphoreCreateBinary();
+#endif
+}
+
+IsrDispatcher::~IsrDispatcher() {
+    vSemaphoreDelete(sem_h);
+}
+
+void IsrDispatcher::defer_from_isr(Deferred *deferred, BaseType_t *higher_prio_woken) {
+    if (deferred->queued.exchange(true, std::memory_order_acq_rel)) {
+        // Already queued, the newer value is picked up by the same apply
+        return;
+    }
+
+    Deferred *head = pending.load(std::memory_order_relaxed);
+    do {
+        deferred->next = head;
+    } while (!pending.compare_exchange_weak(head, deferred, std::memory_order_release, std::memory_order_relaxed));
+
+    xSemaphoreGiveFromISR(sem_h, higher_prio_woken);
+}
+
+bool IsrDispatcher::wait(TickType_t timeout) {
+    return xSemaphoreTake(sem_h, timeout) == pdTRUE;
+}
+
+size_t IsrDispatcher::process(void) {
+    size_t count = 0;
+    Deferred *deferred = pending.exchange(nullptr, std::memory_order_acquire);
+    while (deferred) {
+        Deferred *next = deferred->next;
+        // Cleared before applying so a write during apply queues the object again
+        deferred->queued.store(false, std::memory_order_release);
+        deferred->apply();
+        deferred = next;
+        count++;
+    }
+    return count;
+}
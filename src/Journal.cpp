@@ -0,0 +1,183 @@
+// Internal includes
+#include "Data/Helper/Journal.hpp"
+#include "Data/Helper/Arena.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+#include "esp_log.h"
+#include "esp_rom_crc.h"
+
+// Standard library includes
+#include <cstring>
+
+#define TAG "Journal"
+
+using namespace Data::Helper;
+
+Journal::Journal(const char *label) :
+        partition(label), device(nullptr), pos(0), dirty(false)
+{
+    if (partition.is_open()) {
+        device = &partition;
+    } else {
+        ESP_LOGE(TAG, "No partition %s", label);
+    }
+}
+
+Journal::Journal(FlashDevice *device) :
+        partition(nullptr), device(device), pos(0), dirty(false) { }
+
+bool Journal::is_open(void) const {
+    return device != nullptr;
+}
+
+bool Journal::append(Op op, const char *key, const void *data, size_t data_sz) {
+    size_t key_len = std::strlen(key);
+    if (device == nullptr || dirty || key_len > MAX_KEY_LEN || data_sz > UINT16_MAX) {
+        return false;
+    }
+    size_t size = record_size(key_len, data_sz);
+    if (pos + size > device->get_size()) {
+        return false;
+    }
+
+    uint8_t head[sizeof(Header) + MAX_KEY_LEN];
+    Header header = {(uint8_t)op, (uint8_t)key_len, (uint16_t)data_sz};
+    std::memcpy(head, &header, sizeof(header));
+    std::memcpy(&head[sizeof(header)], key, key_len);
+    uint32_t crc = esp_rom_crc32_le(0, head, sizeof(header) + key_len);
+    if (data_sz > 0) {
+        crc = esp_rom_crc32_le(crc, static_cast<const uint8_t *>(data), data_sz);
+    }
+
+    // The crc is written last so a record torn by a power loss never checks out
+    esp_err_t err = device->write(pos, head, sizeof(header) + key_len);
+    if (err == ESP_OK && data_sz > 0) {
+        err = device->write(pos + sizeof(header) + key_len, data, data_sz);
+    }
+    if (err == ESP_OK) {
+        err = device->write(pos + size - sizeof(crc), &crc, sizeof(crc));
+    }
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Error appending %s: %s", key, esp_err_to_name(err));
+        dirty = true;
+        return false;
+    }
+    pos += size;
+    return true;
+}
+
+size_t Journal::replay(const replay_cb_t &cb) {
+    if (device == nullptr) {
+        return 0;
+    }
+
+    // Find the intact records and the largest one before reading any of them out
+    Header header;
+    size_t size;
+    size_t end = 0;
+    size_t max_data = 0;
+    while (check_record(end, header, size)) {
+        if (header.data_len > max_data) max_data = header.data_len;
+        end += size;
+    }
+    if (end + sizeof(header) <= device->get_size()) {
+        const uint8_t erased[sizeof(header)] = {0xff, 0xff, 0xff, 0xff};
+        device->read(end, &header, sizeof(header));
+        if (std::memcmp(&header, erased, sizeof(header)) != 0) {
+            ESP_LOGW(TAG, "Torn record at %u", (unsigned)end);
+            dirty = true;
+        }
+    }
+
+    size_t count = 0;
+    uint8_t *data = Allocator<uint8_t>().allocate(max_data > 0 ? max_data : 1);
+    for (size_t at = 0; at < end; at += size) {
+        char key[MAX_KEY_LEN + 1];
+        device->read(at, &header, sizeof(header));
+        device->read(at + sizeof(header), key, header.key_len);
+        key[header.key_len] = '\0';
+        device->read(at + sizeof(header) + header.key_len, data, header.data_len);
+        cb((Op)header.op, key, data, header.data_len);
+        size = record_size(header.key_len, header.data_len);
+        count++;
+    }
+    Allocator<uint8_t>().deallocate(data, max_data > 0 ? max_data : 1);
+
+    pos = end;
+    return count;
+}
+
+void Journal::clear(void) {
+    if (device == nullptr || is_empty()) {
+        return;
+    }
+    // A torn record may reach past pos, so the whole log is erased
+    size_t sector_sz = device->get_sector_size();
+    size_t erase_sz = dirty ? device->get_size() : (pos + sector_sz - 1) / sector_sz * sector_sz;
+    // Sectors are erased from the end so that a power loss part way leaves an intact
+    // prefix of records followed by erased flash, never erased flash followed by old records
+    for (size_t offset = erase_sz; offset >= sector_sz; ) {
+        offset -= sector_sz;
+        esp_err_t err = device->erase(offset, sector_sz);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Error erasing: %s", esp_err_to_name(err));
+            dirty = true;
+            return;
+        }
+    }
+    pos = 0;
+    dirty = false;
+}
+
+bool Journal::is_empty(void) const {
+    return pos == 0 && !dirty;
+}
+
+size_t Journal::get_used(void) const {
+    return pos;
+}
+
+size_t Journal::get_capacity(void) const {
+    return device ? device->get_size() : 0;
+}
+
+size_t Journal::record_size(size_t key_len, size_t data_len) {
+    return sizeof(Header) + (key_len + data_len + 3) / 4 * 4 + sizeof(uint32_t);
+}
+
+bool Journal::check_record(size_t at, Header &header, size_t &size) const {
+    if (at + sizeof(header) > device->get_size() ||
+            device->read(at, &header, sizeof(header)) != ESP_OK) {
+        return false;
+    }
+    if ((header.op != (uint8_t)Op::STORE && header.op != (uint8_t)Op::RESET) || header.key_len > MAX_KEY_LEN) {
+        return false;
+    }
+    size = record_size(header.key_len, header.data_len);
+    if (at + size > device->get_size()) {
+        return false;
+    }
+
+    uint8_t chunk[64];
+    std::memcpy(chunk, &header, sizeof(header));
+    uint32_t crc = esp_rom_crc32_le(0, chunk, sizeof(header));
+    size_t remaining = header.key_len + header.data_len;
+    size_t offset = at + sizeof(header);
+    while (remaining > 0) {
+        size_t n = remaining < sizeof(chunk) ? remaining : sizeof(chunk);
+        if (device->read(offset, chunk, n) != ESP_OK) {
+            return false;
+        }
+        crc = esp_rom_crc32_le(crc, chunk, n);
+        offset += n;
+        remaining -= n;
+    }
+
+    uint32_t stored_crc;
+    if (device->read(at + size - sizeof(stored_crc), &stored_crc, sizeof(stored_crc)) != ESP_OK) {
+        return false;
+    }
+    return stored_crc == crc;
+}
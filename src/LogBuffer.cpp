@@ -0,0 +1,116 @@
+// Internal includes
+#include "Data/Helper/LogBuffer.hpp"
+#include "Data/BaseData.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+#include "sdkconfig.h"
+
+// Standard library includes
+#include <cstring>
+
+#ifndef CONFIG_DATA_LOG_BUFFER_SIZE
+#define CONFIG_DATA_LOG_BUFFER_SIZE 2048
+#endif
+
+using namespace Data;
+using namespace Data::Helper;
+
+static uint8_t s_log_buf[CONFIG_DATA_LOG_BUFFER_SIZE];
+static uint8_t s_log_scratch[CONFIG_DATA_LOG_BUFFER_SIZE];
+
+LogBuffer *Helper::GetLogBuffer(void) {
+    static LogBuffer *log_buffer = create<LogBuffer>(s_log_buf, s_log_scratch, sizeof(s_log_buf));
+    return log_buffer;
+}
+
+LogBuffer::LogBuffer(uint8_t *buf, uint8_t *scratch, size_t buf_sz) :
+        buf(buf), scratch(scratch), buf_sz(buf_sz), pos(0), draining(false), dropped(0)
+{
+#if CONFIG_DATA_NO_HEAP
+    sem_h = xSemaphoreCreateBinaryStatic(&sem_buf);
+#else
+    sem_h = xSemaphoreCreateBinary();
+#endif
+    xSemaphoreGive(sem_h);
+}
+
+LogBuffer::~LogBuffer() {
+    vSemaphoreDelete(sem_h);
+}
+
+uint8_t *LogBuffer::begin_record(const BaseDataGeneric *src, size_t prev_sz, size_t next_sz) {
+    xSemaphoreTake(sem_h, portMAX_DELAY);
+    size_t record_sz = sizeof(Header) + prev_sz + next_sz;
+    if (prev_sz > UINT16_MAX || next_sz > UINT16_MAX || record_sz > buf_sz - pos) {
+        dropped++;
+        xSemaphoreGive(sem_h);
+        return nullptr;
+    }
+
+    Header header = {src, (uint16_t)prev_sz, (uint16_t)next_sz};
+    std::memcpy(&buf[pos], &header, sizeof(header));
+    uint8_t *payload = &buf[pos + sizeof(header)];
+    pos += record_sz;
+    return payload;
+}
+
+void LogBuffer::end_record(void) {
+    xSemaphoreGive(sem_h);
+}
+
+void LogBuffer::drain(Writer &writer) {
+    xSemaphoreTake(sem_h, portMAX_DELAY);
+    if (draining) {
+        xSemaphoreGive(sem_h);
+        return;
+    }
+    draining = true;
+    size_t end = pos;
+    std::memcpy(scratch, buf, end);
+    xSemaphoreGive(sem_h);
+
+    size_t written = 0;
+    while (written < end && !writer.is_full()) {
+        Header header;
+        std::memcpy(&header, &scratch[written], sizeof(header));
+        const uint8_t *prev = &scratch[written + sizeof(header)];
+        const uint8_t *next = prev + header.prev_sz;
+        const char *name = header.src->get_name();
+
+        if (writer.get_mode() == Writer::Mode::JSON) {
+            writer.put("{\"name\":");
+            writer.put_string(name ? name : "");
+            writer.put(",\"prev\":");
+            header.src->format_encoded(writer, prev, header.prev_sz);
+            writer.put(",\"next\":");
+            header.src->format_encoded(writer, next, header.next_sz);
+            writer.put("}\n");
+        } else {
+            if (name) {
+                writer.put(name);
+                writer.put(": ");
+            }
+            header.src->format_encoded(writer, prev, header.prev_sz);
+            writer.put("->");
+            header.src->format_encoded(writer, next, header.next_sz);
+            writer.put('\n');
+        }
+        if (writer.is_full()) {
+            break;
+        }
+        written += sizeof(header) + header.prev_sz + header.next_sz;
+    }
+
+    // Records added while formatting are after the copied ones
+    xSemaphoreTake(sem_h, portMAX_DELAY);
+    std::memmove(buf, &buf[written], pos - written);
+    pos -= written;
+    draining = false;
+    xSemaphoreGive(sem_h);
+}
+
+uint32_t LogBuffer::get_dropped(void) const {
+    return dropped;
+}
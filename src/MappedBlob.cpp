@@ -0,0 +1,130 @@
+// Internal includes
+#include "Data/Helper/MappedBlob.hpp"
+#include "Data/Helper/Arena.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+#include "esp_log.h"
+#include "esp_rom_crc.h"
+
+// Standard library includes
+#include <cstddef>
+
+#define TAG "MappedBlob"
+
+using namespace Data::Helper;
+
+using word_t = std::max_align_t;
+
+MappedBlob::MappedBlob(const char *label, size_t offset, NvsHandler *nvs_handler, const char *nvs_key) :
+        label(label), offset(offset), nvs_handler(nvs_handler), nvs_key(nvs_key),
+        data(nullptr), count(0), elem_sz(0), crc(0), has_crc(false), mmap_handle(0), mapped(false),
+        copy(nullptr), copy_words(0) { }
+
+MappedBlob::~MappedBlob() {
+    close();
+}
+
+bool MappedBlob::open(size_t elem_sz) {
+    close();
+    this->elem_sz = elem_sz;
+    if (label && open_partition(elem_sz)) {
+        return true;
+    }
+    return nvs_handler && nvs_key && open_nvs(elem_sz);
+}
+
+void MappedBlob::close(void) {
+    if (mapped) {
+        esp_partition_munmap(mmap_handle);
+    }
+    if (copy) {
+        Allocator<word_t>().deallocate(static_cast<word_t *>(copy), copy_words);
+    }
+    data = nullptr;
+    count = 0;
+    has_crc = false;
+    mapped = false;
+    copy = nullptr;
+    copy_words = 0;
+}
+
+bool MappedBlob::verify(void) const {
+    if (!has_crc) {
+        return data != nullptr;
+    }
+    return esp_rom_crc32_le(0, static_cast<const uint8_t *>(data), count * elem_sz) == crc;
+}
+
+const void *MappedBlob::get_data(void) const {
+    return data;
+}
+
+size_t MappedBlob::get_count(void) const {
+    return count;
+}
+
+bool MappedBlob::is_mapped(void) const {
+    return mapped;
+}
+
+bool MappedBlob::open_partition(size_t elem_sz) {
+    const esp_partition_t *partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label);
+    if (partition == nullptr) {
+        return false;
+    }
+
+    Header header;
+    esp_err_t err = esp_partition_read(partition, offset, &header, sizeof(header));
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Error reading header of %s: %s", label, esp_err_to_name(err));
+        return false;
+    }
+    size_t data_sz = (size_t)header.count * elem_sz;
+    if (header.magic != MAGIC || header.elem_sz != elem_sz || header.count == 0 ||
+            offset + sizeof(header) + data_sz > partition->size) {
+        ESP_LOGE(TAG, "Invalid table in %s at %u", label, (unsigned)offset);
+        return false;
+    }
+
+    err = esp_partition_mmap(partition, offset + sizeof(header), data_sz, ESP_PARTITION_MMAP_DATA, &data, &mmap_handle);
+    if (err == ESP_OK) {
+        mapped = true;
+    } else {
+        ESP_LOGW(TAG, "Mapping %s failed, copying it: %s", label, esp_err_to_name(err));
+        void *buf = allocate_copy(data_sz);
+        err = esp_partition_read(partition, offset + sizeof(header), buf, data_sz);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Error reading %s: %s", label, esp_err_to_name(err));
+            close();
+            return false;
+        }
+        data = buf;
+    }
+    count = header.count;
+    crc = header.crc;
+    has_crc = true;
+    return true;
+}
+
+bool MappedBlob::open_nvs(size_t elem_sz) {
+    size_t data_sz = nvs_handler->size(nvs_key);
+    if (data_sz == 0 || data_sz % elem_sz != 0) {
+        return false;
+    }
+    void *buf = allocate_copy(data_sz);
+    if (!nvs_handler->load(nvs_key, buf, data_sz)) {
+        close();
+        return false;
+    }
+    data = buf;
+    count = data_sz / elem_sz;
+    return true;
+}
+
+void *MappedBlob::allocate_copy(size_t size) {
+    copy_words = (size + sizeof(word_t) - 1) / sizeof(word_t);
+    copy = Allocator<word_t>().allocate(copy_words);
+    return copy;
+}
@@ -0,0 +1,49 @@
+// Internal includes
+#include "Data/Helper/NvsBackend.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+#include "esp_log.h"
+
+// Standard library includes
+
+#define TAG "NvsBackend"
+
+using namespace Data::Helper;
+
+NvsFlashBackend::NvsFlashBackend(const char *nvs_name, const char *partition) :
+        nvs_name(nvs_name), partition(partition), nvs_handle(0)
+{
+    esp_err_t err;
+    if (partition) {
+        err = nvs_open_from_partition(partition, nvs_name, NVS_READWRITE, &nvs_handle);
+    } else {
+        err = nvs_open(nvs_name, NVS_READWRITE, &nvs_handle);
+    }
+    if (err == ESP_OK) {
+        // DOES NOTHING
+    } else {
+        ESP_LOGE(TAG, "Error opening %s in %s: %s", nvs_name, partition ? partition : "nvs", esp_err_to_name(err));
+    }
+}
+
+NvsFlashBackend::~NvsFlashBackend() {
+    nvs_close(nvs_handle);
+}
+
+esp_err_t NvsFlashBackend::get_blob(const char *key, void *data, size_t *data_sz) {
+    return nvs_get_blob(nvs_handle, key, data, data_sz);
+}
+
+esp_err_t NvsFlashBackend::set_blob(const char *key, const void *data, size_t data_sz) {
+    return nvs_set_blob(nvs_handle, key, data, data_sz);
+}
+
+esp_err_t NvsFlashBackend::erase_key(const char *key) {
+    return nvs_erase_key(nvs_handle, key);
+}
+
+esp_err_t NvsFlashBackend::commit(void) {
+    return nvs_commit(nvs_handle);
+}
@@ -1,5 +1,7 @@
 // Internal includes
 #include "Data/Helper/NvsHandler.hpp"
+#include "Data/Helper/Arena.hpp"
+#include "Data/Helper/Clock.hpp"
 
 // bwl component includes
 
@@ -8,35 +10,38 @@
 
 // Standard library includes
 #include <cstring>
+#include <utility>
 
 #define TAG "NvsHandler"
 
 using namespace Data::Helper;
 
 NvsHandler::NvsHandler(const char *nvs_name) :
-        nvs_name(nvs_name), nvs_handle(0)
-{
-    esp_err_t err = nvs_open(nvs_name, NVS_READWRITE, &nvs_handle);
-    if (err == ESP_OK) {
-        // DOES NOTHING
-    } else {
-        ESP_LOGE(TAG, "Error opening %s: %s", nvs_name, esp_err_to_name(err));
-    }
-}
+        NvsHandler(nvs_name, create<NvsFlashBackend>(nvs_name), true) { }
+
+NvsHandler::NvsHandler(const char *nvs_name, NvsBackend *backend, bool owns_backend) :
+        nvs_name(nvs_name), backend(backend), owns_backend(owns_backend), subs(), key_stats(), commit_stats(), dirty_high_water(0),
+        journal(nullptr), journaling(false), journal_full(false) { }
 
 NvsHandler::~NvsHandler() {
-    esp_err_t err = nvs_commit(nvs_handle);
+    esp_err_t err = backend->commit();
     if (err == ESP_OK) {
         // DOES NOTHING
     } else {
         ESP_LOGE(TAG, "Error committing %s: %s", nvs_name, esp_err_to_name(err));
     }
-    nvs_close(nvs_handle);
+    if (owns_backend) {
+        destroy(backend);
+    }
+}
+
+const char *NvsHandler::get_name(void) const {
+    return nvs_name;
 }
 
 size_t NvsHandler::size(const char *key) {
     size_t length = 0;
-    esp_err_t err = nvs_get_blob(nvs_handle, key, NULL, &length);
+    esp_err_t err = backend->get_blob(key, NULL, &length);
     if (err == ESP_OK) {
         return length;
     } else if (err == ESP_ERR_NVS_NOT_FOUND) {
@@ -48,7 +53,7 @@ size_t NvsHandler::size(const char *key) {
 }
 
 bool NvsHandler::load(const char *key, void *data, size_t data_sz) {
-    esp_err_t err = nvs_get_blob(nvs_handle, key, data, &data_sz);
+    esp_err_t err = backend->get_blob(key, data, &data_sz);
     if (err == ESP_OK) {
         // printf("load succeed\n");
         return true;
@@ -62,9 +67,23 @@ bool NvsHandler::load(const char *key, void *data, size_t data_sz) {
 }
 
 void NvsHandler::store(const char *key, const void *data, size_t data_sz) {
-    esp_err_t err = nvs_set_blob(nvs_handle, key, data, data_sz);
+    if (journaling) {
+        if (!journal->append(Journal::Op::STORE, key, data, data_sz)) {
+            journal_full = true;
+        }
+        return;
+    }
+
+    esp_err_t err = backend->set_blob(key, data, data_sz);
     if (err == ESP_OK) {
-        // DOES NOTHING
+        KeyStats *stats = find_or_add_stats(key);
+        if (stats) {
+            int64_t now = now_us();
+            stats->stores++;
+            stats->bytes += data_sz;
+            stats->last_write_us = now;
+            stats->window.add(now);
+        }
     } else if (err == ESP_ERR_NVS_NOT_FOUND) {
         // DOES NOTHING
     } else {
@@ -73,11 +92,28 @@ void NvsHandler::store(const char *key, const void *data, size_t data_sz) {
 }
 
 void NvsHandler::reset(const char *key) {
+    if (journaling) {
+        if (!journal->append(Journal::Op::RESET, key, nullptr, 0)) {
+            journal_full = true;
+        }
+        return;
+    }
+
     subs.erase(key);
+    if (journal && !journal->is_empty()) {
+        // Stop a replay from bringing back a value the journal still holds
+        journal->append(Journal::Op::RESET, key, nullptr, 0);
+    }
 
-    esp_err_t err = nvs_erase_key(nvs_handle, key);
+    esp_err_t err = backend->erase_key(key);
     if (err == ESP_OK) {
-        // DOES NOTHING
+        KeyStats *stats = find_or_add_stats(key);
+        if (stats) {
+            int64_t now = now_us();
+            stats->resets++;
+            stats->last_write_us = now;
+            stats->window.add(now);
+        }
     } else if (err == ESP_ERR_NVS_NOT_FOUND) {
         // DOES NOTHING
     } else {
@@ -86,7 +122,38 @@ void NvsHandler::reset(const char *key) {
 }
 
 void NvsHandler::sub(const char *key, Block *block) {
-    subs[key] = block;
+    auto it = subs.find(key);
+    if (it != subs.end()) {
+        // Already dirty, the deadline runs from the first change
+        it->second.block = block;
+    } else {
+        Dirty dirty = {block, 0};
+        if (block->get_deadline_ms() > 0) {
+            dirty.due_us = now_us() + (int64_t)block->get_deadline_ms() * 1000;
+        }
+#if CONFIG_DATA_NO_HEAP
+        if (!subs.insert_or_assign(key, dirty)) {
+            ESP_LOGW(TAG, "Dirty keys of %s are full, storing %s now", nvs_name, key);
+            block->commit(this, key);
+        }
+#else
+        subs.emplace(key, dirty);
+#endif
+    }
+    if (subs.size() > dirty_high_water) {
+        dirty_high_water = subs.size();
+    }
+
+    if (journal) {
+        journaling = true;
+        journal_full = false;
+        block->journal(this, key);
+        journaling = false;
+        if (journal_full) {
+            ESP_LOGI(TAG, "Journal of %s is full, compacting", nvs_name);
+            commit();
+        }
+    }
 }
 
 void NvsHandler::unsub(const char *key) {
@@ -94,22 +161,264 @@ void NvsHandler::unsub(const char *key) {
 }
 
 void NvsHandler::commit(void) {
-    for (auto it = subs.begin(); it != subs.end(); it++) {
-        it->second->commit(this, it->first);
-    }
+    commit_slice(UINT32_MAX);
+}
 
+size_t NvsHandler::commit_slice(uint32_t budget_us) {
+    // Blocks may reset their key while committing, which removes it from subs
+    int64_t start = now_us();
+    backend->begin_commit();
+    subs_t pending = std::move(subs);
     subs.clear();
 
-    esp_err_t err = nvs_commit(nvs_handle);
+    // Critical and overdue blocks go in the first pass whatever the budget, then normal and bulk ones
+    bool over_budget = false;
+    for (int pass = 0; pass < 3 && !over_budget; pass++) {
+        for (auto it = pending.begin(); it != pending.end(); it++) {
+            Dirty &dirty = it->second;
+            if (dirty.block == nullptr) {
+                continue;
+            }
+            Priority priority = dirty.block->get_priority();
+            bool due = priority == Priority::CRITICAL || (dirty.due_us != 0 && dirty.due_us <= start);
+            if ((due ? 0 : priority == Priority::NORMAL ? 1 : 2) != pass) {
+                continue;
+            }
+            if (pass > 0 && budget_us != UINT32_MAX && now_us() - start >= budget_us) {
+                over_budget = true;
+                break;
+            }
+
+            Block *block = dirty.block;
+            dirty.block = nullptr;
+            block->commit(this, it->first);
+            KeyStats *stats = find_or_add_stats(it->first);
+            if (stats) {
+                stats->commits++;
+            }
+        }
+    }
+
+    // Carry the rest over to the next slice, keeping their deadlines
+    for (auto it = pending.begin(); it != pending.end(); it++) {
+        if (it->second.block && subs.find(it->first) == subs.end()) {
+#if CONFIG_DATA_NO_HEAP
+            subs.insert_or_assign(it->first, it->second);
+#else
+            subs.emplace(it->first, it->second);
+#endif
+        }
+    }
+
+    esp_err_t err = backend->commit();
+    uint64_t us = now_us() - start;
+    commit_stats.commits++;
+    commit_stats.total_us += us;
+    commit_stats.last_us = us;
+    if (us > commit_stats.worst_us) {
+        commit_stats.worst_us = us;
+    }
     if (err == ESP_OK) {
         // DOES NOTHING
     } else if (err == ESP_ERR_NVS_NOT_FOUND) {
         // DOES NOTHING
     } else {
         ESP_LOGE(TAG, "Error committing %s: %s", nvs_name, esp_err_to_name(err));
+        commit_stats.failed++;
+        return subs.size();
     }
+
+    // The journal still holds the only durable copy of anything carried over
+    if (journal && subs.empty()) {
+        journal->clear();
+    }
+    return subs.size();
+}
+
+uint32_t NvsHandler::get_deadline_wait_ms(void) const {
+    int64_t earliest = 0;
+    for (auto it = subs.begin(); it != subs.end(); it++) {
+        if (it->second.due_us != 0 && (earliest == 0 || it->second.due_us < earliest)) {
+            earliest = it->second.due_us;
+        }
+    }
+    if (earliest == 0) {
+        return UINT32_MAX;
+    }
+    int64_t wait_us = earliest - now_us();
+    return wait_us > 0 ? (uint32_t)((wait_us + 999) / 1000) : 0;
+}
+
+size_t NvsHandler::get_dirty_count(void) const {
+    return subs.size();
+}
+
+size_t NvsHandler::set_journal(Journal *journal) {
+    this->journal = nullptr;
+    size_t count = 0;
+    if (journal && journal->is_open()) {
+        count = journal->replay([this](Journal::Op op, const char *key, const uint8_t *data, size_t data_sz) {
+            if (op == Journal::Op::STORE) {
+                store(key, data, data_sz);
+            } else {
+                reset(key);
+            }
+        });
+        if (count > 0) {
+            ESP_LOGI(TAG, "Replayed %u journal records into %s", (unsigned)count, nvs_name);
+        }
+        commit();
+        journal->clear();
+        this->journal = journal;
+    }
+    return count;
+}
+
+size_t NvsHandler::get_dirty_high_water(void) const {
+    return dirty_high_water;
+}
+
+size_t NvsHandler::get_dirty_capacity(void) const {
+#if CONFIG_DATA_NO_HEAP
+    return CONFIG_DATA_NVS_MAX_DIRTY;
+#else
+    return 0;
+#endif
+}
+
+const NvsHandler::KeyStats *NvsHandler::get_key_stats(const char *key) const {
+    auto it = key_stats.find(make_name(key));
+    return it != key_stats.end() ? &it->second : nullptr;
+}
+
+float NvsHandler::get_write_rate(const char *key) const {
+    const KeyStats *stats = get_key_stats(key);
+    if (stats == nullptr) {
+        return 0;
+    }
+    return stats->window.count(now_us()) * 3600.0f / CONFIG_DATA_NVS_WEAR_WINDOW;
+}
+
+void NvsHandler::for_each_key_stats(const key_stats_cb_t &cb) const {
+    for (auto it = key_stats.begin(); it != key_stats.end(); it++) {
+        cb(it->first.str, it->second);
+    }
+}
+
+const NvsHandler::CommitStats &NvsHandler::get_commit_stats(void) const {
+    return commit_stats;
+}
+
+void NvsHandler::export_key_stats(Writer &writer, const char *key) const {
+    const KeyStats *stats = get_key_stats(key);
+    KeyStats none = KeyStats();
+    if (stats == nullptr) {
+        stats = &none;
+    }
+    int64_t ago_s = stats->last_write_us > 0 ? (now_us() - stats->last_write_us) / 1000000 : -1;
+
+    if (writer.get_mode() == Writer::Mode::JSON) {
+        writer.put("{\"stores\":");
+        writer.put_uint(stats->stores);
+        writer.put(",\"resets\":");
+        writer.put_uint(stats->resets);
+        writer.put(",\"bytes\":");
+        writer.put_uint(stats->bytes);
+        writer.put(",\"commits\":");
+        writer.put_uint(stats->commits);
+        writer.put(",\"per_hour\":");
+        writer.put_float(get_write_rate(key));
+        writer.put(",\"last_s\":");
+        writer.put_int(ago_s);
+        writer.put('}');
+    } else {
+        writer.put("stores=");
+        writer.put_uint(stats->stores);
+        writer.put(" resets=");
+        writer.put_uint(stats->resets);
+        writer.put(" bytes=");
+        writer.put_uint(stats->bytes);
+        writer.put(" commits=");
+        writer.put_uint(stats->commits);
+        writer.put(" per_hour=");
+        writer.put_float(get_write_rate(key));
+        writer.put(" last_s=");
+        writer.put_int(ago_s);
+    }
+}
+
+void NvsHandler::reset_stats(void) {
+    key_stats.clear();
+    commit_stats = CommitStats();
+}
+
+NvsHandler::KeyName NvsHandler::make_name(const char *key) {
+    KeyName name;
+    std::strncpy(name.str, key, sizeof(name.str) - 1);
+    name.str[sizeof(name.str) - 1] = '\0';
+    return name;
+}
+
+NvsHandler::KeyStats *NvsHandler::find_or_add_stats(const char *key) {
+    KeyName name = make_name(key);
+    auto it = key_stats.find(name);
+    if (it != key_stats.end()) {
+        return &it->second;
+    }
+#if CONFIG_DATA_NO_HEAP
+    // Keys beyond the capacity go uncounted
+    if (!key_stats.insert_or_assign(name, KeyStats())) {
+        return nullptr;
+    }
+    return &key_stats.find(name)->second;
+#else
+    return &key_stats[name];
+#endif
 }
 
 bool NvsHandler::CmpKey::operator() (const char *k1, const char *k2) const {
     return std::strcmp(k1, k2) < 0;
 }
+
+bool NvsHandler::CmpName::operator() (const KeyName &k1, const KeyName &k2) const {
+    return std::strcmp(k1.str, k2.str) < 0;
+}
+
+NvsHandler::RateWindow::RateWindow(void) :
+        buckets(), last_epoch(0) { }
+
+void NvsHandler::RateWindow::add(int64_t now_us) {
+    int64_t epoch = now_us / bucket_us();
+    if (epoch - last_epoch >= (int64_t)BUCKETS) {
+        for (auto &bucket : buckets) {
+            bucket = 0;
+        }
+    } else {
+        for (int64_t e = last_epoch + 1; e <= epoch; e++) {
+            buckets[e % BUCKETS] = 0;
+        }
+    }
+    if (epoch > last_epoch) {
+        last_epoch = epoch;
+    }
+    uint16_t &bucket = buckets[last_epoch % BUCKETS];
+    if (bucket < UINT16_MAX) {
+        bucket++;
+    }
+}
+
+uint32_t NvsHandler::RateWindow::count(int64_t now_us) const {
+    int64_t epoch = now_us / bucket_us();
+    uint32_t total = 0;
+    for (size_t i = 0; i < BUCKETS; i++) {
+        int64_t e = last_epoch - i;
+        if (e >= 0 && epoch - e < (int64_t)BUCKETS) {
+            total += buckets[e % BUCKETS];
+        }
+    }
+    return total;
+}
+
+int64_t NvsHandler::RateWindow::bucket_us(void) {
+    return (int64_t)CONFIG_DATA_NVS_WEAR_WINDOW * 1000000 / BUCKETS;
+}
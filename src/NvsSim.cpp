@@ -0,0 +1,307 @@
+// Internal includes
+#include "Data/Helper/NvsSim.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+#include "esp_log.h"
+#include "esp_rom_crc.h"
+
+// Standard library includes
+#include <cstring>
+
+#define TAG "NvsSim"
+
+using namespace Data::Helper;
+
+namespace {
+    constexpr size_t PAGE_HEADER_SZ = 32;
+    constexpr size_t BITMAP_SZ = 32;
+    constexpr uint8_t ENTRY_WRITTEN = 0b10;
+    constexpr uint8_t ENTRY_ERASED = 0b00;
+    constexpr uint32_t PAGE_ACTIVE = 0xfffffffe;
+    constexpr uint32_t PAGE_FULL = 0xfffffffc;
+};
+
+NvsSim::NvsSim(FlashSim *flash) :
+        flash(flash), pages(), items(), active(-1), next_seq(0), live_entries(0), commit_start_us(0), stats()
+{
+    if (flash->get_sector_size() < PAGE_HEADER_SZ + BITMAP_SZ + PAGE_ENTRIES * ENTRY_SZ) {
+        ESP_LOGE(TAG, "Sectors of %u bytes can't hold a page", (unsigned)flash->get_sector_size());
+        return;
+    }
+    pages.resize(flash->get_size() / flash->get_sector_size(), Page{PageState::EMPTY, 0, 0, 0});
+}
+
+esp_err_t NvsSim::get_blob(const char *key, void *data, size_t *data_sz) {
+    auto it = items.find(key);
+    if (it == items.end()) {
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+    if (data == nullptr) {
+        *data_sz = it->second.size;
+        return ESP_OK;
+    }
+    if (*data_sz < it->second.size) {
+        return ESP_ERR_NVS_INVALID_LENGTH;
+    }
+    *data_sz = it->second.size;
+    return read_item(it->second, static_cast<uint8_t *>(data));
+}
+
+esp_err_t NvsSim::set_blob(const char *key, const void *data, size_t data_sz) {
+    stats.sets++;
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    auto it = items.find(key);
+    if (it != items.end() && matches(it->second, bytes, data_sz)) {
+        stats.skipped_sets++;
+        return ESP_OK;
+    }
+
+    // The old entries are only erased once the new ones are written, so they can't make room
+    size_t max_chunk = (PAGE_ENTRIES - 1) * ENTRY_SZ;
+    size_t needed = (data_sz + ENTRY_SZ - 1) / ENTRY_SZ + data_sz / max_chunk + 1;
+    if (pages.empty() || needed + live_entries > (pages.size() - 1) * PAGE_ENTRIES) {
+        return ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+    }
+
+    Item item;
+    esp_err_t err = write_item(key, bytes, data_sz, item);
+    if (err != ESP_OK) {
+        erase_item(item);
+        return err;
+    }
+    if (it != items.end()) {
+        erase_item(it->second);
+        it->second = std::move(item);
+    } else {
+        items.emplace(key, std::move(item));
+    }
+    return ESP_OK;
+}
+
+esp_err_t NvsSim::erase_key(const char *key) {
+    auto it = items.find(key);
+    if (it == items.end()) {
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+    erase_item(it->second);
+    items.erase(it);
+    stats.erased_keys++;
+    return ESP_OK;
+}
+
+void NvsSim::begin_commit(void) {
+    commit_start_us = flash->get_time_us();
+}
+
+esp_err_t NvsSim::commit(void) {
+    uint64_t us = flash->get_time_us() - commit_start_us;
+    if (us > stats.worst_commit_us) {
+        stats.worst_commit_us = us;
+    }
+    stats.commits++;
+    return ESP_OK;
+}
+
+const NvsSim::Stats &NvsSim::get_stats(void) const {
+    return stats;
+}
+
+void NvsSim::reset_stats(void) {
+    stats = Stats();
+}
+
+size_t NvsSim::get_live_entries(void) const {
+    return live_entries;
+}
+
+size_t NvsSim::entry_offset(uint16_t page, uint16_t entry) const {
+    return page * flash->get_sector_size() + PAGE_HEADER_SZ + BITMAP_SZ + entry * ENTRY_SZ;
+}
+
+void NvsSim::set_state(uint16_t page, uint16_t entry, uint16_t span, uint8_t state) {
+    // Two bits per entry, a state change only clears bits so it is a single program
+    uint8_t bitmap[BITMAP_SZ];
+    size_t first = entry / 4;
+    size_t last = (entry + span - 1) / 4;
+    size_t offset = page * flash->get_sector_size() + PAGE_HEADER_SZ;
+    flash->read(offset + first, &bitmap[first], last - first + 1);
+    for (size_t e = entry; e < (size_t)entry + span; e++) {
+        bitmap[e / 4] &= ~((~state & 0b11) << (e % 4 * 2));
+    }
+    flash->write(offset + first, &bitmap[first], last - first + 1);
+}
+
+void NvsSim::write_page_header(uint16_t page) {
+    uint8_t header[PAGE_HEADER_SZ];
+    uint32_t state = PAGE_ACTIVE;
+    uint32_t seq = pages[page].seq;
+    std::memset(header, 0xff, sizeof(header));
+    std::memcpy(&header[0], &state, sizeof(state));
+    std::memcpy(&header[4], &seq, sizeof(seq));
+    uint32_t crc = esp_rom_crc32_le(0, &header[4], sizeof(header) - 8);
+    std::memcpy(&header[sizeof(header) - 4], &crc, sizeof(crc));
+    flash->write(page * flash->get_sector_size(), header, sizeof(header));
+}
+
+esp_err_t NvsSim::activate_page(void) {
+    if (active >= 0) {
+        uint32_t state = PAGE_FULL;
+        flash->write(active * flash->get_sector_size(), &state, sizeof(state));
+        pages[active].state = PageState::FULL;
+        active = -1;
+    }
+
+    int empty = -1;
+    size_t empty_count = 0;
+    for (size_t i = 0; i < pages.size(); i++) {
+        if (pages[i].state == PageState::EMPTY) {
+            if (empty < 0) empty = i;
+            empty_count++;
+        }
+    }
+    if (empty_count <= 1) {
+        return collect();
+    }
+
+    active = empty;
+    pages[active] = Page{PageState::ACTIVE, next_seq++, 0, 0};
+    write_page_header(active);
+    return ESP_OK;
+}
+
+esp_err_t NvsSim::collect(void) {
+    int victim = -1;
+    int reserve = -1;
+    for (size_t i = 0; i < pages.size(); i++) {
+        if (pages[i].state == PageState::EMPTY) {
+            reserve = i;
+        } else if (pages[i].state == PageState::FULL && pages[i].erased > 0 &&
+                (victim < 0 || pages[i].seq < pages[victim].seq)) {
+            victim = i;
+        }
+    }
+    if (victim < 0 || reserve < 0) {
+        return ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+    }
+
+    // Live chunks move to the reserve page, which becomes the active page
+    active = reserve;
+    pages[active] = Page{PageState::ACTIVE, next_seq++, 0, 0};
+    write_page_header(active);
+
+    uint8_t buffer[PAGE_ENTRIES * ENTRY_SZ];
+    for (auto &item : items) {
+        for (auto &chunk : item.second.chunks) {
+            if (chunk.page != victim) {
+                continue;
+            }
+            flash->read(entry_offset(chunk.page, chunk.entry), buffer, chunk.span * ENTRY_SZ);
+            chunk.page = active;
+            chunk.entry = pages[active].used;
+            flash->write(entry_offset(chunk.page, chunk.entry), buffer, chunk.span * ENTRY_SZ);
+            set_state(chunk.page, chunk.entry, chunk.span, ENTRY_WRITTEN);
+            pages[active].used += chunk.span;
+            stats.entries_relocated += chunk.span;
+        }
+    }
+
+    flash->erase(victim * flash->get_sector_size(), flash->get_sector_size());
+    pages[victim] = Page{PageState::EMPTY, 0, 0, 0};
+    stats.gc_count++;
+    return ESP_OK;
+}
+
+esp_err_t NvsSim::write_chunk(const char *key, const uint8_t *data, size_t data_sz, Chunk &chunk) {
+    // A chunk needs room for its header and at least one data entry
+    while (active < 0 || PAGE_ENTRIES - pages[active].used < 2) {
+        esp_err_t err = activate_page();
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
+
+    size_t room = (PAGE_ENTRIES - pages[active].used - 1) * ENTRY_SZ;
+    size_t n = data_sz < room ? data_sz : room;
+    chunk.page = active;
+    chunk.entry = pages[active].used;
+    chunk.span = 1 + (n + ENTRY_SZ - 1) / ENTRY_SZ;
+    chunk.data_sz = n;
+
+    uint8_t header[ENTRY_SZ];
+    uint16_t size = n;
+    uint32_t crc = esp_rom_crc32_le(0, data, n);
+    std::memset(header, 0xff, sizeof(header));
+    header[0] = 0x42; // Blob data type
+    header[1] = chunk.span;
+    std::memcpy(&header[4], &crc, sizeof(crc));
+    size_t key_len = std::strlen(key);
+    std::memcpy(&header[8], key, key_len < 16 ? key_len : 16);
+    std::memcpy(&header[24], &size, sizeof(size));
+
+    flash->write(entry_offset(chunk.page, chunk.entry), header, sizeof(header));
+    esp_err_t err = flash->write(entry_offset(chunk.page, chunk.entry + 1), data, n);
+    pages[active].used += chunk.span;
+    if (err != ESP_OK) {
+        // Entries written but never marked are skipped, the page erase reclaims them
+        pages[active].erased += chunk.span;
+        return err;
+    }
+    set_state(chunk.page, chunk.entry, chunk.span, ENTRY_WRITTEN);
+    live_entries += chunk.span;
+    stats.entries_written += chunk.span;
+    return ESP_OK;
+}
+
+esp_err_t NvsSim::write_item(const char *key, const uint8_t *data, size_t data_sz, Item &item) {
+    item.size = data_sz;
+    size_t offset = 0;
+    do {
+        Chunk chunk;
+        esp_err_t err = write_chunk(key, data + offset, data_sz - offset, chunk);
+        if (err != ESP_OK) {
+            return err;
+        }
+        item.chunks.push_back(chunk);
+        offset += chunk.data_sz;
+    } while (offset < data_sz);
+    return ESP_OK;
+}
+
+void NvsSim::erase_item(const Item &item) {
+    for (const auto &chunk : item.chunks) {
+        set_state(chunk.page, chunk.entry, chunk.span, ENTRY_ERASED);
+        pages[chunk.page].erased += chunk.span;
+        live_entries -= chunk.span;
+    }
+}
+
+bool NvsSim::matches(const Item &item, const uint8_t *data, size_t data_sz) {
+    if (item.size != data_sz) {
+        return false;
+    }
+    uint8_t buffer[64];
+    for (const auto &chunk : item.chunks) {
+        for (size_t at = 0; at < chunk.data_sz; at += sizeof(buffer)) {
+            size_t n = chunk.data_sz - at < sizeof(buffer) ? chunk.data_sz - at : sizeof(buffer);
+            flash->read(entry_offset(chunk.page, chunk.entry + 1) + at, buffer, n);
+            if (std::memcmp(buffer, data + at, n) != 0) {
+                return false;
+            }
+        }
+        data += chunk.data_sz;
+    }
+    return true;
+}
+
+esp_err_t NvsSim::read_item(const Item &item, uint8_t *data) {
+    for (const auto &chunk : item.chunks) {
+        esp_err_t err = flash->read(entry_offset(chunk.page, chunk.entry + 1), data, chunk.data_sz);
+        if (err != ESP_OK) {
+            return err;
+        }
+        data += chunk.data_sz;
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,73 @@
+// Internal includes
+#include "Data/Helper/ObjectArena.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+
+// Standard library includes
+
+using namespace Data::Helper;
+
+using word_t = std::max_align_t;
+
+ObjectArena::ObjectArena(size_t chunk_sz) :
+        chunks(nullptr), pos(nullptr), end(nullptr), cleanups(nullptr),
+        chunk_sz(chunk_sz), used(0), reserved(0) { }
+
+ObjectArena::~ObjectArena() {
+    clear();
+}
+
+void *ObjectArena::allocate(size_t size, size_t align) {
+    uint8_t *aligned = (uint8_t *)(((uintptr_t)pos + align - 1) & ~(uintptr_t)(align - 1));
+    if (pos != nullptr && aligned + size <= end) {
+        used += aligned + size - pos;
+        pos = aligned + size;
+        return aligned;
+    }
+
+    // Chunk headers are padded to a word so the data after them is fully aligned
+    size_t header_sz = (sizeof(Chunk) + sizeof(word_t) - 1) / sizeof(word_t) * sizeof(word_t);
+    size_t data_sz = size > chunk_sz ? size : chunk_sz;
+    size_t words = (header_sz + data_sz + sizeof(word_t) - 1) / sizeof(word_t);
+    Chunk *chunk = reinterpret_cast<Chunk *>(Allocator<word_t>().allocate(words));
+    chunk->next = chunks;
+    chunk->size = words;
+    chunks = chunk;
+    reserved += words * sizeof(word_t);
+    used += size;
+
+    uint8_t *data = reinterpret_cast<uint8_t *>(chunk) + header_sz;
+    if (size < chunk_sz) {
+        // Keep filling the new chunk, oversized requests leave the current one in use
+        pos = data + size;
+        end = reinterpret_cast<uint8_t *>(chunk) + words * sizeof(word_t);
+    }
+    return data;
+}
+
+void ObjectArena::clear(void) {
+    while (cleanups) {
+        Cleanup *cleanup = cleanups;
+        cleanups = cleanup->next;
+        cleanup->destroy(cleanup->object);
+    }
+    while (chunks) {
+        Chunk *chunk = chunks;
+        chunks = chunk->next;
+        Allocator<word_t>().deallocate(reinterpret_cast<word_t *>(chunk), chunk->size);
+    }
+    pos = nullptr;
+    end = nullptr;
+    used = 0;
+    reserved = 0;
+}
+
+size_t ObjectArena::get_used(void) const {
+    return used;
+}
+
+size_t ObjectArena::get_reserved(void) const {
+    return reserved;
+}
@@ -0,0 +1,56 @@
+// Internal includes
+#include "Data/Executor/QueueExecutor.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+
+// Standard library includes
+
+using namespace Data;
+
+QueueExecutor::QueueExecutor(size_t capacity) :
+        queue(capacity), dropped(0), runner(nullptr)
+{
+#if CONFIG_DATA_NO_HEAP
+    sem_h = xSemaphoreCreateCountingStatic(queue.capacity(), 0, &sem_buf);
+#else
+    sem_h = xSemaphoreCreateCounting(queue.capacity(), 0);
+#endif
+}
+
+QueueExecutor::~QueueExecutor() {
+    vSemaphoreDelete(sem_h);
+}
+
+bool QueueExecutor::post(work_fn_t fn, void *arg) {
+    if (!queue.try_push(Work{fn, arg})) {
+        dropped++;
+        return false;
+    }
+    xSemaphoreGive(sem_h);
+    return true;
+}
+
+size_t QueueExecutor::run(TickType_t timeout) {
+    size_t count = 0;
+    runner = xTaskGetCurrentTaskHandle();
+    if (xSemaphoreTake(sem_h, timeout) == pdTRUE) {
+        do {
+            Work work = {nullptr, nullptr};
+            if (queue.try_pop([&work](Work &queued) { work = queued; })) {
+                work.fn(work.arg);
+                count++;
+            }
+        } while (xSemaphoreTake(sem_h, 0) == pdTRUE);
+    }
+    return count;
+}
+
+bool QueueExecutor::is_current(void) const {
+    return runner == xTaskGetCurrentTaskHandle();
+}
+
+uint32_t QueueExecutor::get_dropped(void) const {
+    return dropped;
+}
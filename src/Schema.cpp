@@ -0,0 +1,45 @@
+// Internal includes
+#include "Data/Helper/Schema.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+#include "esp_log.h"
+
+// Standard library includes
+#include <cstring>
+#include <memory>
+
+#define TAG "Schema"
+
+using namespace Data;
+using namespace Data::Helper;
+
+bool Helper::read_blob(NvsHandler &handler, const char *key, const blob_cb_t &blob_cb) {
+    size_t blob_sz = handler.size(key);
+    if (blob_sz == 0) {
+        return false;
+    }
+#if CONFIG_DATA_NO_HEAP
+    if (blob_sz > CONFIG_DATA_MIGRATE_MAX_SIZE) {
+        ESP_LOGW(TAG, "%s is %u bytes, too big to migrate", key, (unsigned)blob_sz);
+        return false;
+    }
+    uint8_t buf[CONFIG_DATA_MIGRATE_MAX_SIZE];
+#else
+    std::unique_ptr<uint8_t[]> owned(new uint8_t[blob_sz]);
+    uint8_t *buf = owned.get();
+#endif
+    if (!handler.load(key, buf, blob_sz)) {
+        return false;
+    }
+
+    BlobHeader header;
+    if (blob_sz >= sizeof(header)) {
+        std::memcpy(&header, buf, sizeof(header));
+        if (header.magic == BlobHeader::MAGIC && header.size == blob_sz - sizeof(header)) {
+            return blob_cb(header.version, buf + sizeof(header), header.size);
+        }
+    }
+    return blob_cb(0, buf, blob_sz);
+}
@@ -0,0 +1,173 @@
+// Internal includes
+#include "Data/Helper/SubMonitor.hpp"
+#include "Data/BaseData.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+#include "esp_log.h"
+
+// Standard library includes
+#include <cstring>
+
+#define TAG "SubMonitor"
+
+using namespace Data;
+using namespace Data::Helper;
+
+// Created with the static objects, so notifies from any task find it without a lock
+static SubMonitor s_sub_monitor;
+
+SubMonitor *Helper::GetSubMonitor(void) {
+    return &s_sub_monitor;
+}
+
+SubMonitor::SubMonitor(void) :
+        budget_us(CONFIG_DATA_SUB_BUDGET_US), executor(nullptr), demote_after(3),
+        offenders(), count(0), dropped(0)
+{
+#if CONFIG_DATA_NO_HEAP
+    sem_h = xSemaphoreCreateBinaryStatic(&sem_buf);
+#else
+    sem_h = xSemaphoreCreateBinary();
+#endif
+    xSemaphoreGive(sem_h);
+}
+
+SubMonitor::~SubMonitor() {
+    vSemaphoreDelete(sem_h);
+}
+
+void SubMonitor::set_budget_us(uint32_t budget_us) {
+    this->budget_us = budget_us;
+}
+
+uint32_t SubMonitor::get_budget_us(void) const {
+    return budget_us;
+}
+
+void SubMonitor::set_demotion(Executor *executor, uint32_t after) {
+    xSemaphoreTake(sem_h, portMAX_DELAY);
+    this->executor = executor;
+    demote_after = after;
+    xSemaphoreGive(sem_h);
+}
+
+Executor *SubMonitor::get_demotion_executor(void) const {
+    xSemaphoreTake(sem_h, portMAX_DELAY);
+    Executor *demotion_executor = executor;
+    xSemaphoreGive(sem_h);
+    return demotion_executor;
+}
+
+Executor *SubMonitor::record(const BaseDataGeneric *src, size_t sub_id, uint32_t us) {
+    const char *name = src->get_name() ? src->get_name() : "";
+    xSemaphoreTake(sem_h, portMAX_DELAY);
+    Offender *offender = nullptr;
+    for (size_t i = 0; i < count; i++) {
+        if (offenders[i].src == src && offenders[i].sub_id == sub_id) {
+            offender = &offenders[i];
+            break;
+        }
+    }
+    if (offender == nullptr) {
+        if (count == CONFIG_DATA_SUB_MONITOR_SIZE) {
+            dropped++;
+            xSemaphoreGive(sem_h);
+            return nullptr;
+        }
+        offender = &offenders[count++];
+        *offender = {src, sub_id, {}, 0, 0, 0, false};
+        std::strncpy(offender->name, name, sizeof(offender->name) - 1);
+        ESP_LOGW(TAG, "Subscriber %u of %s took %u us", (unsigned)sub_id, name, (unsigned)us);
+    }
+
+    offender->count++;
+    offender->last_us = us;
+    if (us > offender->worst_us) offender->worst_us = us;
+    Executor *demote_to = nullptr;
+    if (executor != nullptr && !offender->demoted && offender->count >= demote_after) {
+        demote_to = executor;
+        offender->demoted = true;
+        ESP_LOGW(TAG, "Subscriber %u of %s demoted after %u calls over budget", (unsigned)sub_id, name, (unsigned)offender->count);
+    }
+    xSemaphoreGive(sem_h);
+    return demote_to;
+}
+
+void SubMonitor::forget(const BaseDataGeneric *src, size_t sub_id) {
+    remove(src, false, sub_id);
+}
+
+void SubMonitor::forget(const BaseDataGeneric *src) {
+    remove(src, true, 0);
+}
+
+void SubMonitor::remove(const BaseDataGeneric *src, bool any_id, size_t sub_id) {
+    xSemaphoreTake(sem_h, portMAX_DELAY);
+    for (size_t i = 0; i < count; ) {
+        if (offenders[i].src == src && (any_id || offenders[i].sub_id == sub_id)) {
+            offenders[i] = offenders[--count];
+        } else {
+            i++;
+        }
+    }
+    xSemaphoreGive(sem_h);
+}
+
+void SubMonitor::for_each_offender(const offender_cb_t &cb) const {
+    xSemaphoreTake(sem_h, portMAX_DELAY);
+    for (size_t i = 0; i < count; i++) {
+        cb(offenders[i]);
+    }
+    xSemaphoreGive(sem_h);
+}
+
+void SubMonitor::export_to(Writer &writer) const {
+    bool json = writer.get_mode() == Writer::Mode::JSON;
+    bool first = true;
+    if (json) writer.put('[');
+    for_each_offender([&](const Offender &offender) {
+        if (json) {
+            if (!first) writer.put(',');
+            writer.put("{\"name\":");
+            writer.put_string(offender.name);
+            writer.put(",\"sub_id\":");
+            writer.put_uint(offender.sub_id);
+            writer.put(",\"count\":");
+            writer.put_uint(offender.count);
+            writer.put(",\"last_us\":");
+            writer.put_uint(offender.last_us);
+            writer.put(",\"worst_us\":");
+            writer.put_uint(offender.worst_us);
+            writer.put(",\"demoted\":");
+            writer.put_bool(offender.demoted);
+            writer.put('}');
+        } else {
+            writer.put(offender.name);
+            writer.put('#');
+            writer.put_uint(offender.sub_id);
+            writer.put(": count=");
+            writer.put_uint(offender.count);
+            writer.put(" last_us=");
+            writer.put_uint(offender.last_us);
+            writer.put(" worst_us=");
+            writer.put_uint(offender.worst_us);
+            if (offender.demoted) writer.put(" demoted");
+            writer.put('\n');
+        }
+        first = false;
+    });
+    if (json) writer.put(']');
+}
+
+void SubMonitor::clear(void) {
+    xSemaphoreTake(sem_h, portMAX_DELAY);
+    count = 0;
+    dropped = 0;
+    xSemaphoreGive(sem_h);
+}
+
+uint32_t SubMonitor::get_dropped(void) const {
+    return dropped;
+}
@@ -0,0 +1,210 @@
+// Internal includes
+#include "Data/Helper/Writer.hpp"
+
+// bwl component includes
+
+// Esp-idf component includes
+
+// Standard library includes
+#include <cmath>
+#include <cstdio>
+
+using namespace Data::Helper;
+
+BufferSink::BufferSink(char *buf, size_t buf_sz) :
+        buf(buf), buf_sz(buf_sz), pos(0) { }
+
+size_t BufferSink::write(const char *data, size_t data_sz) {
+    size_t n = data_sz < buf_sz - pos ? data_sz : buf_sz - pos;
+    std::memcpy(&buf[pos], data, n);
+    pos += n;
+    return n;
+}
+
+size_t BufferSink::size(void) const {
+    return pos;
+}
+
+StdoutSink::StdoutSink(void) :
+        pos(0) { }
+
+StdoutSink::~StdoutSink() {
+    fwrite(buf, 1, pos, stdout);
+}
+
+size_t StdoutSink::write(const char *data, size_t data_sz) {
+    for (size_t i = 0; i < data_sz; i++) {
+        if (pos == sizeof(buf)) {
+            fwrite(buf, 1, pos, stdout);
+            pos = 0;
+        }
+        buf[pos++] = data[i];
+    }
+    return data_sz;
+}
+
+Writer::Writer(Sink &sink, Mode mode, size_t skip) :
+        sink(sink), mode(mode), skip(skip), produced(0), full(false) { }
+
+Writer::Mode Writer::get_mode(void) const {
+    return mode;
+}
+
+bool Writer::is_full(void) const {
+    return full;
+}
+
+size_t Writer::get_produced(void) const {
+    return produced;
+}
+
+void Writer::put(const char *data, size_t data_sz) {
+    size_t start = produced;
+    produced += data_sz;
+    if (full || produced <= skip) {
+        return;
+    }
+    if (start < skip) {
+        data += skip - start;
+        data_sz -= skip - start;
+    }
+    if (sink.write(data, data_sz) < data_sz) {
+        full = true;
+    }
+}
+
+void Writer::put(const char *str) {
+    put(str, std::strlen(str));
+}
+
+void Writer::put(char c) {
+    put(&c, 1);
+}
+
+void Writer::put_uint(uint64_t value) {
+    char digits[20];
+    size_t i = sizeof(digits);
+    do {
+        digits[--i] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    put(&digits[i], sizeof(digits) - i);
+}
+
+void Writer::put_int(int64_t value) {
+    if (value < 0) {
+        put('-');
+        put_uint(0 - (uint64_t)value);
+    } else {
+        put_uint((uint64_t)value);
+    }
+}
+
+void Writer::put_float(double value) {
+    if (std::isnan(value) || std::isinf(value)) {
+        if (mode == Mode::JSON) {
+            put("null");
+        } else if (std::isnan(value)) {
+            put("nan");
+        } else {
+            put(value < 0 ? "-inf" : "inf");
+        }
+        return;
+    }
+    if (value < 0) {
+        put('-');
+        value = -value;
+    }
+
+    int exponent = 0;
+    if (value != 0 && (value >= 1e15 || value < 1e-5)) {
+        exponent = (int)std::floor(std::log10(value));
+        value /= std::pow(10.0, exponent);
+    }
+
+    // Six digits after the point, trailing zeros trimmed
+    uint64_t integer = (uint64_t)value;
+    uint64_t fraction = (uint64_t)std::llround((value - (double)integer) * 1e6);
+    if (fraction >= 1000000) {
+        integer++;
+        fraction -= 1000000;
+    }
+    put_uint(integer);
+    if (fraction > 0) {
+        char digits[7] = {'.'};
+        size_t len = 7;
+        for (size_t i = 6; i > 0; i--) {
+            digits[i] = (char)('0' + fraction % 10);
+            fraction /= 10;
+        }
+        while (digits[len - 1] == '0') {
+            len--;
+        }
+        put(digits, len);
+    }
+    if (exponent != 0) {
+        put('e');
+        put_int(exponent);
+    }
+}
+
+void Writer::put_bool(bool value) {
+    put(value ? "true" : "false");
+}
+
+void Writer::put_string(const char *str, size_t str_sz) {
+    if (mode == Mode::TEXT) {
+        put(str, str_sz);
+        return;
+    }
+
+    put('"');
+    size_t run = 0;
+    for (size_t i = 0; i < str_sz; i++) {
+        unsigned char c = (unsigned char)str[i];
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        put(&str[run], i - run);
+        run = i + 1;
+        switch (c) {
+            case '"': put("\\\""); break;
+            case '\\': put("\\\\"); break;
+            case '\n': put("\\n"); break;
+            case '\r': put("\\r"); break;
+            case '\t': put("\\t"); break;
+            default: {
+                static const char hex[] = "0123456789abcdef";
+                char escape[6] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF]};
+                put(escape, sizeof(escape));
+                break;
+            }
+        }
+    }
+    put(&str[run], str_sz - run);
+    put('"');
+}
+
+void Writer::put_string(const char *str) {
+    put_string(str, std::strlen(str));
+}
+
+void Writer::put_hex(const void *data, size_t data_sz) {
+    static const char hex[] = "0123456789abcdef";
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    if (mode == Mode::JSON) put('"');
+    put("0x");
+    for (size_t i = 0; i < data_sz; i++) {
+        char byte[2] = {hex[bytes[i] >> 4], hex[bytes[i] & 0xF]};
+        put(byte, sizeof(byte));
+    }
+    if (mode == Mode::JSON) put('"');
+}
+
+void Writer::put_indent(uint32_t depth) {
+    if (mode == Mode::TEXT) {
+        for (uint32_t i = 0; i < depth; i++) {
+            put("  ", 2);
+        }
+    }
+}